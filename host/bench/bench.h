@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include "system.h"
+
+// Host benchmarks for the firmware hot paths.
+//
+// Each case runs a firmware function against the simulated board in virtual
+// time (see HostSim::setVirtualTime), so bus traffic and busy-wait delays are
+// counted exactly and cost no host time. The runner reports, per call or per
+// frame, the bus operations, the modeled Cortex-M0 cycles they take and an
+// estimate of the cycles spent computing, scaled from host time.
+
+namespace Bench {
+
+    // The firmware objects the cases run against. The system task is built
+    // but never started, so nothing runs behind the benchmark's back.
+    struct Firmware {
+        explicit Firmware(System::SystemTask& systask);
+
+        System::SystemTask& systask;
+        Settings& settings;
+        UART uart;
+        ST7565 st7565;
+        UI ui;
+        BK4819 bk4819;
+        RadioNS::Radio radio;
+        Applications::MainVFO mainVFO;
+        Applications::Menu menu;
+        Applications::Messenger messenger;
+        SPISoftwareInterface spi;
+        I2C i2c;
+        EEPROM eeprom;
+    };
+
+    struct Case {
+        const char* name;
+        const char* unit;           // "call", "frame", "tick" or "byte"
+        uint32_t iterations;
+        void (*setup)(Firmware& fw);
+        void (*run)(Firmware& fw, uint32_t iteration);
+        Case* next;
+    };
+
+    // Cases register themselves from static constructors, in file order
+    struct Registrar {
+        Registrar(Case& benchCase);
+    };
+
+} // namespace Bench
+
+#define BENCH_CASE(id, name, unit, iterations, setup, run) \
+    static Bench::Case id##Case = { name, unit, iterations, setup, run, nullptr }; \
+    static Bench::Registrar id##Registrar(id##Case)
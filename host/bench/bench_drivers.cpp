@@ -0,0 +1,105 @@
+// Bus drivers: BK4819 3-wire SPI, EEPROM I2C and the UART1 command scanner
+
+#include <cstring>
+
+#include "bench.h"
+#include "host_sim.h"
+
+namespace {
+
+    constexpr uint16_t EEPROM_CHANNEL_1 = 0x0050;  // first memory channel, straddles a page
+    constexpr uint16_t EEPROM_SCRATCH = 0x1D20;    // page aligned, the first settings journal slot
+    constexpr uint16_t SEQUENTIAL_SIZE = 512;
+
+    uint8_t eepromData[2][EEPROM::PAGE_SIZE];
+    uint8_t sequentialData[SEQUENTIAL_SIZE];
+
+    void spiWriteRegister(Bench::Firmware& fw, uint32_t i) {
+        fw.spi.writeRegister(0x38, (uint16_t)(0x1234U + i));
+    }
+
+    void spiReadRegister(Bench::Firmware& fw, uint32_t) {
+        fw.spi.readRegister(0x38);
+    }
+
+    // A sequential random read, the way EEPROM::readBuffer frames it
+    void i2cReadBuffer(Bench::Firmware& fw, uint32_t) {
+        uint8_t buffer[32];
+
+        fw.i2c.start();
+        fw.i2c.write(EEPROM::BASE_ADDRESS);
+        fw.i2c.write((uint8_t)(EEPROM_CHANNEL_1 >> 8));
+        fw.i2c.write((uint8_t)EEPROM_CHANNEL_1);
+        fw.i2c.start();
+        fw.i2c.write(EEPROM::BASE_ADDRESS | I2C::READ);
+        fw.i2c.readBuffer(buffer, sizeof(buffer));
+        fw.i2c.stop();
+    }
+
+    // One long read every SEQUENTIAL_SIZE calls: the row is per byte, per_s
+    // is the streaming rate with the address phase spread over the block
+    void eepromReadSequential(Bench::Firmware& fw, uint32_t i) {
+        if (i % SEQUENTIAL_SIZE == 0) {
+            fw.eeprom.readBuffer(EEPROM_CHANNEL_1, sequentialData, SEQUENTIAL_SIZE);
+        }
+    }
+
+    void eepromSetup(Bench::Firmware&) {
+        for (uint8_t i = 0; i < EEPROM::PAGE_SIZE; i++) {
+            eepromData[0][i] = i;
+            eepromData[1][i] = (uint8_t)~i;
+        }
+    }
+
+    // Every call changes the data, so both pages are rewritten
+    void eepromWriteChanged(Bench::Firmware& fw, uint32_t i) {
+        fw.eeprom.writeBuffer(EEPROM_CHANNEL_1, eepromData[i & 1U], EEPROM::PAGE_SIZE);
+    }
+
+    // Same data every call, only the read-compare runs
+    void eepromWriteUnchanged(Bench::Firmware& fw, uint32_t) {
+        fw.eeprom.writeBuffer(EEPROM_SCRATCH, eepromData[0], EEPROM::PAGE_SIZE);
+    }
+
+    void uartIdle(Bench::Firmware& fw, uint32_t) {
+        fw.uart.isCommandAvailable();
+    }
+
+    // 0x0514 hello, the first command of every CHIRP / CPS session
+    struct {
+        uint16_t id;
+        uint16_t size;
+        uint32_t timestamp;
+    } helloPayload = { 0x0514, 4, 0x6B5A0000U };
+
+    uint8_t helloPacket[4 + sizeof(helloPayload) + 4];
+
+    void uartHelloSetup(Bench::Firmware&) {
+        uint16_t crc = CRCCalculate(&helloPayload, sizeof(helloPayload));
+
+        helloPacket[0] = 0xAB;
+        helloPacket[1] = 0xCD;
+        helloPacket[2] = (uint8_t)sizeof(helloPayload);
+        helloPacket[3] = 0;
+        memcpy(&helloPacket[4], &helloPayload, sizeof(helloPayload));
+        helloPacket[4 + sizeof(helloPayload)] = (uint8_t)crc;
+        helloPacket[5 + sizeof(helloPayload)] = (uint8_t)(crc >> 8);
+        helloPacket[6 + sizeof(helloPayload)] = 0xDC;
+        helloPacket[7 + sizeof(helloPayload)] = 0xBA;
+    }
+
+    void uartHello(Bench::Firmware& fw, uint32_t) {
+        HostSim::uartReceive(helloPacket, sizeof(helloPacket));
+        fw.uart.isCommandAvailable();
+    }
+
+} // namespace
+
+BENCH_CASE(spiWrite, "spi.writeRegister", "call", 2000, nullptr, spiWriteRegister);
+BENCH_CASE(spiRead, "spi.readRegister", "call", 2000, nullptr, spiReadRegister);
+BENCH_CASE(i2cRead, "i2c.readBuffer.32", "call", 500, nullptr, i2cReadBuffer);
+BENCH_CASE(eepromSequential, "eeprom.readBuffer.sequential", "byte", 8 * SEQUENTIAL_SIZE, nullptr, eepromReadSequential);
+BENCH_CASE(eepromChanged, "eeprom.writeBuffer.32.changed", "call", 100, eepromSetup, eepromWriteChanged);
+BENCH_CASE(eepromUnchanged, "eeprom.writeBuffer.32.unchanged", "call", 100, eepromSetup, eepromWriteUnchanged);
+BENCH_CASE(uartIdle, "uart.isCommandAvailable.idle", "call", 20000, nullptr, uartIdle);
+BENCH_CASE(uartHello, "uart.isCommandAvailable.0514", "call", 2000, uartHelloSetup, uartHello);
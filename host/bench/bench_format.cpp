@@ -0,0 +1,94 @@
+// Text formatting: the printf library the UI used against the typed Fmt
+// layer, on the strings a frame draws. Each pair formats the same text.
+
+#include "printf.h"
+
+#include "bench.h"
+#include "text_format.h"
+
+namespace {
+
+    char text[TEXT_SIZE];
+    volatile char sink;
+
+    // A VFO frequency as drawFrequencySmall lays it out, 145.512.50
+    uint32_t frequency(uint32_t i) {
+        return 14550000U + i * 1250U;
+    }
+
+    void frequencyPrintf(Bench::Firmware&, uint32_t i) {
+        uint32_t freq = frequency(i);
+        snprintf(text, sizeof(text), "%3u.%03u.%02u", freq / 100000, (freq % 100000) / 100, freq % 100);
+        sink = text[0];
+    }
+
+    void frequencyTyped(Bench::Firmware&, uint32_t i) {
+        uint32_t freq = frequency(i);
+        Fmt::format(text, sizeof(text), Fmt::pad<3>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100), '.', Fmt::zero<2>(freq % 100));
+        sink = text[0];
+    }
+
+    // The list position in the menu title bars
+    void counterPrintf(Bench::Firmware&, uint32_t i) {
+        snprintf(text, sizeof(text), "%02u / %02u", (unsigned)(i % 17 + 1), 17U);
+        sink = text[0];
+    }
+
+    void counterTyped(Bench::Firmware&, uint32_t i) {
+        Fmt::format(text, sizeof(text), Fmt::zero<2>(i % 17 + 1), " / ", Fmt::zero<2>(17));
+        sink = text[0];
+    }
+
+    // The VFO status line, "FM 26K HIGH"
+    void statusPrintf(Bench::Firmware&, uint32_t i) {
+        const char* modulation = Settings::modulationStr.get((uint8_t)(i % Settings::modulationStr.COUNT));
+        const char* bandwidth = Settings::bandwidthStr.get((uint8_t)(i % Settings::bandwidthStr.COUNT));
+        const char* power = Settings::powerStr.get((uint8_t)(i % Settings::powerStr.COUNT));
+        snprintf(text, sizeof(text), "%s %sK %s", modulation, bandwidth, power);
+        sink = text[0];
+    }
+
+    void statusTyped(Bench::Firmware&, uint32_t i) {
+        const char* modulation = Settings::modulationStr.get((uint8_t)(i % Settings::modulationStr.COUNT));
+        const char* bandwidth = Settings::bandwidthStr.get((uint8_t)(i % Settings::bandwidthStr.COUNT));
+        const char* power = Settings::powerStr.get((uint8_t)(i % Settings::powerStr.COUNT));
+        Fmt::format(text, sizeof(text), modulation, ' ', bandwidth, "K ", power);
+        sink = text[0];
+    }
+
+    // A DCS code label
+    void dcsPrintf(Bench::Firmware&, uint32_t i) {
+        snprintf(text, sizeof(text), "D%03o", Settings::DCSOptions[i % 104]);
+        sink = text[0];
+    }
+
+    void dcsTyped(Bench::Firmware&, uint32_t i) {
+        Fmt::format(text, sizeof(text), 'D', Fmt::oct<3>(Settings::DCSOptions[i % 104]));
+        sink = text[0];
+    }
+
+    // Battery on the welcome screen, "87% 7.62V"
+    void batteryPrintf(Bench::Firmware&, uint32_t i) {
+        uint32_t voltage = 700 + i % 150;
+        snprintf(text, sizeof(text), "%i%% %u.%02uV", (int)(i % 101), voltage / 100, voltage % 100);
+        sink = text[0];
+    }
+
+    void batteryTyped(Bench::Firmware&, uint32_t i) {
+        uint32_t voltage = 700 + i % 150;
+        Fmt::format(text, sizeof(text), Fmt::percent((int32_t)(i % 101)), ' ', Fmt::fixed<2>(voltage), 'V');
+        sink = text[0];
+    }
+
+} // namespace
+
+BENCH_CASE(frequencyPrintf, "fmt.frequency.printf", "call", 5000, nullptr, frequencyPrintf);
+BENCH_CASE(frequencyTyped, "fmt.frequency.typed", "call", 5000, nullptr, frequencyTyped);
+BENCH_CASE(counterPrintf, "fmt.counter.printf", "call", 5000, nullptr, counterPrintf);
+BENCH_CASE(counterTyped, "fmt.counter.typed", "call", 5000, nullptr, counterTyped);
+BENCH_CASE(statusPrintf, "fmt.status.printf", "call", 5000, nullptr, statusPrintf);
+BENCH_CASE(statusTyped, "fmt.status.typed", "call", 5000, nullptr, statusTyped);
+BENCH_CASE(dcsPrintf, "fmt.dcs.printf", "call", 5000, nullptr, dcsPrintf);
+BENCH_CASE(dcsTyped, "fmt.dcs.typed", "call", 5000, nullptr, dcsTyped);
+BENCH_CASE(batteryPrintf, "fmt.battery.printf", "call", 5000, nullptr, batteryPrintf);
+BENCH_CASE(batteryTyped, "fmt.battery.typed", "call", 5000, nullptr, batteryTyped);
@@ -0,0 +1,299 @@
+// Benchmark runner: builds the firmware objects on the simulated board and
+// prints one tab separated row per case. Arguments select cases by name
+// prefix, "--list" prints the case names.
+//
+// Columns, all per call (or per frame) except "calls":
+//   gpio_wr / gpio_rd   pin writes and reads through gpio_hal.h
+//   systick             SysTick polls made by busy-wait delays
+//   bk4819_wr / _rd     BK4819 register transfers seen by the model
+//   eeprom_pages        EEPROM page write cycles
+//   lcd_bytes           bytes sent to the ST7565
+//   bus_cycles          modeled cycles of the pin accesses and delays
+//   cpu_cycles          host_ns less the bus accesses, scaled to the target
+//   m0_cycles / m0_us   bus_cycles + cpu_cycles, and that at 48 MHz
+//   per_s               calls (or frames) per second at that cost
+//   host_ns             host time of the firmware code alone
+//
+// Each batch runs twice: once against the models, recording every pin read,
+// then again replaying those reads with the models bypassed. The counters
+// come from the first run, host_ns from the second.
+//
+// bus_cycles is exact for a given build, cpu_cycles is an estimate: compare
+// it against a baseline taken on the same host. UVK_BENCH_M0_PER_NS sets the
+// target cycles per host nanosecond (default 20).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "host_sim.h"
+#include "bk4819_model.h"
+#include "eeprom_model.h"
+#include "st7565_model.h"
+
+#include "bench.h"
+
+// No UART, keypad or screen threads: the runner owns the firmware
+bool HostSim::headless = true;
+
+// Hooks src/main.cpp provides to FreeRTOS and printf, the scheduler never
+// starts here
+extern "C" {
+
+    void _putchar(__attribute__((unused)) char c) {}
+
+    void vApplicationStackOverflowHook(__attribute__((unused)) TaskHandle_t pxTask, __attribute__((unused)) char* pcTaskName) {
+        abort();
+    }
+
+    void vApplicationGetIdleTaskMemory(StaticTask_t** ppxIdleTaskTCBBuffer,
+        StackType_t** ppxIdleTaskStackBuffer,
+        uint32_t* pulIdleTaskStackSize) {
+        *ppxIdleTaskTCBBuffer = nullptr;
+        *ppxIdleTaskStackBuffer = nullptr;
+        *pulIdleTaskStackSize = 0;
+    }
+
+    void vApplicationGetTimerTaskMemory(StaticTask_t** ppxTimerTaskTCBBuffer,
+        StackType_t** ppxTimerTaskStackBuffer,
+        uint32_t* pulTimerTaskStackSize) {
+        *ppxTimerTaskTCBBuffer = nullptr;
+        *ppxTimerTaskStackBuffer = nullptr;
+        *pulTimerTaskStackSize = 0;
+    }
+
+}
+
+namespace Bench {
+
+    namespace {
+
+        constexpr uint8_t BATCHES = 5;
+        constexpr uint32_t CALIBRATION_LOOPS = 200000;
+        constexpr uint32_t CALIBRATION_DELAY_MS = 50;
+        constexpr size_t TRACE_SIZE = 1U << 20;
+        constexpr double DEFAULT_M0_PER_NS = 20.0;
+
+        Case* firstCase = nullptr;
+        Case* lastCase = nullptr;
+
+        uint32_t readTrace[TRACE_SIZE];
+
+        // Host time of one bus access while replaying
+        struct HookCost {
+            double gpioWriteNs;
+            double gpioReadNs;
+            double sysTickNs;
+        };
+
+        HookCost hookCost;
+
+        struct Sample {
+            HostSim::BusCounters bus;
+            uint32_t bkWrites;
+            uint32_t bkReads;
+            uint32_t eepromPages;
+            uint32_t lcdBytes;
+        };
+
+        uint64_t hostNs(void) {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+        }
+
+        Sample sample(void) {
+            HostSim::ST7565Model& display = HostSim::display();
+            Sample s;
+            s.bus = HostSim::busCounters();
+            s.bkWrites = HostSim::bk4819().getWriteCount();
+            s.bkReads = HostSim::bk4819().getReadCount();
+            s.eepromPages = HostSim::eeprom().getPageWriteCount();
+            s.lcdBytes = display.getDataBytes() + display.getCommandBytes();
+            return s;
+        }
+
+        void calibrate(void) {
+            HostSim::setReadTrace(HostSim::TraceMode::REPLAY, readTrace, TRACE_SIZE);
+
+            uint64_t start = hostNs();
+            for (uint32_t i = 0; i < CALIBRATION_LOOPS; i++) {
+                GPIO_FlipBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+            }
+            uint64_t writes = hostNs();
+            for (uint32_t i = 0; i < CALIBRATION_LOOPS; i++) {
+                GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT);
+            }
+            uint64_t reads = hostNs();
+            // A whole delay loop pass, which is what SYSTICK_POLL_CYCLES stands for
+            uint64_t pollsBefore = HostSim::busCounters().sysTickReads;
+            delayMs(CALIBRATION_DELAY_MS);
+            uint64_t polls = HostSim::busCounters().sysTickReads - pollsBefore;
+            uint64_t delays = hostNs();
+
+            HostSim::setReadTrace(HostSim::TraceMode::OFF, nullptr, 0);
+
+            hookCost.gpioWriteNs = (double)(writes - start) / CALIBRATION_LOOPS;
+            hookCost.gpioReadNs = (double)(reads - writes) / CALIBRATION_LOOPS;
+            hookCost.sysTickNs = (double)(delays - reads) / (double)polls;
+        }
+
+        bool selected(const char* name, int argc, char** argv) {
+            if (argc < 2) {
+                return true;
+            }
+            for (int i = 1; i < argc; i++) {
+                if (strncmp(name, argv[i], strlen(argv[i])) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void runCase(Firmware& fw, Case& benchCase, double m0PerNs) {
+            if (benchCase.setup) {
+                benchCase.setup(fw);
+            }
+            // First pass warms the host caches and any lazy firmware state
+            benchCase.run(fw, 0);
+
+            // Counters are deterministic, host time is not: keep the fastest
+            // replay
+            Sample start = {};
+            Sample end = {};
+            uint64_t replayNs = UINT64_MAX;
+            bool replayed = true;
+
+            for (uint8_t batch = 0; batch < BATCHES; batch++) {
+                HostSim::setReadTrace(HostSim::TraceMode::RECORD, readTrace, TRACE_SIZE);
+                start = sample();
+                for (uint32_t i = 0; i < benchCase.iterations; i++) {
+                    benchCase.run(fw, i);
+                }
+                end = sample();
+                size_t reads = HostSim::getReadTracePosition();
+
+                HostSim::setReadTrace(HostSim::TraceMode::REPLAY, readTrace, reads);
+                uint64_t replayStart = hostNs();
+                for (uint32_t i = 0; i < benchCase.iterations; i++) {
+                    benchCase.run(fw, i);
+                }
+                uint64_t replayEnd = hostNs();
+                replayed = replayed && reads < TRACE_SIZE && HostSim::getReadTracePosition() == reads;
+                HostSim::setReadTrace(HostSim::TraceMode::OFF, nullptr, 0);
+
+                if (replayEnd - replayStart < replayNs) {
+                    replayNs = replayEnd - replayStart;
+                }
+            }
+
+            if (!replayed) {
+                fprintf(stderr, "%s: replay diverged, cpu_cycles is not valid\n", benchCase.name);
+            }
+
+            double n = benchCase.iterations;
+            double firmwareNs = (double)replayNs / n;
+            double gpioWrites = (double)(end.bus.gpioWrites - start.bus.gpioWrites) / n;
+            double gpioReads = (double)(end.bus.gpioReads - start.bus.gpioReads) / n;
+            double sysTickReads = (double)(end.bus.sysTickReads - start.bus.sysTickReads) / n;
+
+            double hookNs = gpioWrites * hookCost.gpioWriteNs + gpioReads * hookCost.gpioReadNs +
+                sysTickReads * hookCost.sysTickNs;
+            double busCycles = (double)(end.bus.cycles - start.bus.cycles) / n;
+            double cpuCycles = firmwareNs > hookNs ? (firmwareNs - hookNs) * m0PerNs : 0.0;
+            double m0Cycles = busCycles + cpuCycles;
+
+            fprintf(stdout, "%s\t%s\t%u\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.2f\t%.1f\t%.0f\t%.0f\t%.0f\t%.1f\t%.0f\t%.0f\n",
+                benchCase.name, benchCase.unit, benchCase.iterations,
+                gpioWrites, gpioReads, sysTickReads,
+                (double)(end.bkWrites - start.bkWrites) / n,
+                (double)(end.bkReads - start.bkReads) / n,
+                (double)(end.eepromPages - start.eepromPages) / n,
+                (double)(end.lcdBytes - start.lcdBytes) / n,
+                busCycles, cpuCycles, m0Cycles,
+                m0Cycles / HostSim::CPU_CLOCK_MHZ,
+                m0Cycles > 0 ? HostSim::CPU_CLOCK_MHZ * 1e6 / m0Cycles : 0.0, firmwareNs);
+            fflush(stdout);
+        }
+
+    } // namespace
+
+    Registrar::Registrar(Case& benchCase) {
+        if (lastCase) {
+            lastCase->next = &benchCase;
+        }
+        else {
+            firstCase = &benchCase;
+        }
+        lastCase = &benchCase;
+    }
+
+    Firmware::Firmware(System::SystemTask& systask) :
+        systask{ systask },
+        settings{ systask.getSettings() },
+        uart(settings),
+        st7565(),
+        ui(st7565, uart),
+        bk4819(),
+        radio(systask, uart, bk4819, settings),
+        mainVFO(systask, ui, radio),
+        menu(systask, ui, radio),
+        messenger(systask, ui, radio) {
+
+        st7565.begin();
+        bk4819.setupRegisters();
+
+        // A freshly initialised radio: default settings and both VFOs tuned
+        settings.setRadioSettingsDefault();
+        settings.saveRadioSettings();
+        radio.setVFO(Settings::VFOAB::VFOA, settings.radioSettings.vfo[(uint8_t)Settings::VFOAB::VFOA]);
+        radio.setVFO(Settings::VFOAB::VFOB, settings.radioSettings.vfo[(uint8_t)Settings::VFOAB::VFOB]);
+        radio.setActiveVFO(settings.radioSettings.vfoSelected);
+        radio.setRadioReady(true);
+    }
+
+} // namespace Bench
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--list") == 0) {
+        for (Bench::Case* c = Bench::firstCase; c; c = c->next) {
+            fprintf(stdout, "%s\n", c->name);
+        }
+        return 0;
+    }
+
+    double m0PerNs = Bench::DEFAULT_M0_PER_NS;
+    if (const char* scale = getenv("UVK_BENCH_M0_PER_NS")) {
+        m0PerNs = strtod(scale, nullptr);
+    }
+
+    HostSim::setVirtualTime(true);
+
+    configureSysTick();
+    configureSysCon();
+    boardGPIOInit();
+    boardPORTCONInit();
+    boardADCInit();
+    CRCInit();
+
+    Bench::calibrate();
+
+    static System::SystemTask systemTask;
+    static Bench::Firmware firmware(systemTask);
+
+    // The frame cases run once per buffer pass, this is what they trade for
+    fprintf(stderr, "display buffer: %u bytes, %u pages per pass\n",
+        (unsigned)(ST7565::BUFFER_PAGES * W), (unsigned)ST7565::BUFFER_PAGES);
+
+    fprintf(stdout, "name\tunit\tcalls\tgpio_wr\tgpio_rd\tsystick\tbk4819_wr\tbk4819_rd\teeprom_pages\tlcd_bytes"
+        "\tbus_cycles\tcpu_cycles\tm0_cycles\tm0_us\tper_s\thost_ns\n");
+
+    for (Bench::Case* c = Bench::firstCase; c; c = c->next) {
+        if (Bench::selected(c->name, argc, argv)) {
+            Bench::runCase(firmware, *c, m0PerNs);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+// Radio: retuning the BK4819 to a VFO, what every VFO switch and dual watch
+// swap costs
+
+#include "bench.h"
+
+namespace {
+
+    void setupToVFO(Bench::Firmware& fw, uint32_t i) {
+        fw.radio.setupToVFO((i & 1U) ? Settings::VFOAB::VFOB : Settings::VFOAB::VFOA);
+    }
+
+    // One dual watch hop, with the receiver already on
+    void setRXVFO(Bench::Firmware& fw, uint32_t i) {
+        fw.radio.setRXVFO((i & 1U) ? Settings::VFOAB::VFOB : Settings::VFOAB::VFOA);
+    }
+
+    // Mode changes rewrite most of the demodulator fields
+    constexpr ModType modulations[] = { ModType::MOD_FM, ModType::MOD_WFM, ModType::MOD_AM, ModType::MOD_USB };
+
+    void setModulation(Bench::Firmware& fw, uint32_t i) {
+        ModType type = modulations[i % (sizeof(modulations) / sizeof(modulations[0]))];
+        fw.bk4819.setModulation(type);
+        fw.bk4819.setAGC(true, type == ModType::MOD_AM, (uint8_t)(i % 19));
+    }
+
+} // namespace
+
+BENCH_CASE(setupToVFO, "radio.setupToVFO", "call", 500, nullptr, setupToVFO);
+BENCH_CASE(setRXVFO, "radio.setRXVFO", "call", 500, nullptr, setRXVFO);
+BENCH_CASE(setModulation, "bk4819.setModulation+setAGC", "call", 400, nullptr, setModulation);
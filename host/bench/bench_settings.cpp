@@ -0,0 +1,54 @@
+// Settings saves: what one saveRadioSettings() costs in EEPROM page writes
+// for the changes the radio saves most
+
+#include <cstring>
+
+#include "bench.h"
+
+namespace {
+
+    constexpr uint16_t JOURNAL_START = 0x1D10;
+    constexpr uint16_t JOURNAL_SIZE = 0x1E00 - JOURNAL_START;
+
+    // Starts from the defaults in the record at 0x0000 and an empty journal
+    void saveSetup(Bench::Firmware& fw) {
+        uint8_t erased[JOURNAL_SIZE];
+        memset(erased, 0xFF, sizeof(erased));
+        fw.settings.getEEPROM().writeBuffer(JOURNAL_START, erased, sizeof(erased));
+
+        fw.settings.setRadioSettingsDefault();
+        fw.settings.getEEPROM().writeBuffer(0x0000, &fw.settings.radioSettings, sizeof(Settings::SETTINGS));
+        fw.settings.getRadioSettings();
+    }
+
+    // Tuning VFO A in 12.5 kHz steps
+    void saveTune(Bench::Firmware& fw, uint32_t i) {
+        Settings::VFO& vfo = fw.settings.radioSettings.vfo[0];
+        vfo.rx.frequency = 14500000U + (i % 64U) * 1250U;
+        vfo.tx.frequency = vfo.rx.frequency;
+        fw.settings.saveRadioSettings();
+    }
+
+    // Dual watch use: both VFOs tuned, the selected one swapping
+    void saveDualTune(Bench::Firmware& fw, uint32_t i) {
+        uint8_t index = (uint8_t)(i & 1U);
+        Settings::VFO& vfo = fw.settings.radioSettings.vfo[index];
+        vfo.rx.frequency = (index ? 44000000U : 14500000U) + ((i / 2U) % 64U) * 1250U;
+        vfo.tx.frequency = vfo.rx.frequency;
+        fw.settings.radioSettings.vfoSelected = index ? Settings::VFOAB::VFOB : Settings::VFOAB::VFOA;
+        fw.settings.saveRadioSettings();
+    }
+
+    // Menu changes spread over the record: every VFO name byte in turn,
+    // more than one journal entry holds
+    void saveSpread(Bench::Firmware& fw, uint32_t i) {
+        Settings::VFO& vfo = fw.settings.radioSettings.vfo[i & 1U];
+        vfo.name[(i / 2U) % 10U] = (char)('A' + (i % 26U));
+        fw.settings.saveRadioSettings();
+    }
+
+} // namespace
+
+BENCH_CASE(saveTune, "settings.save.tune", "call", 140, saveSetup, saveTune);
+BENCH_CASE(saveDualTune, "settings.save.dualTune", "call", 140, saveSetup, saveDualTune);
+BENCH_CASE(saveSpread, "settings.save.spread", "call", 140, saveSetup, saveSpread);
@@ -0,0 +1,106 @@
+// UI: tone code labels, the big frequency digits, app frames and an idle
+// app tick. The frame cases report the display bytes the dirty segment
+// tracking lets through
+
+#include "bench.h"
+#include "code_labels.h"
+
+namespace {
+
+    volatile uint8_t labelLength;
+
+    // A label from the compile time tables, as the VFO screen shows it
+    void ctcssLabel(Bench::Firmware& fw, uint32_t i) {
+        labelLength = fw.ui.stringLengthNL(CodeLabels::CTCSS.get((uint8_t)(i % CodeLabels::CTCSS_COUNT)));
+    }
+
+    void dcsLabel(Bench::Firmware& fw, uint32_t i) {
+        labelLength = fw.ui.stringLengthNL(CodeLabels::DCS.get((uint8_t)(i % CodeLabels::DCS_COUNT)));
+    }
+
+    // The VFO frequencies the big digits cases cycle through
+    constexpr uint32_t FREQUENCIES[] = { 14550000, 43312500, 2712500, 124600000 };
+
+    // drawFrequencyBig as it was before the glyph cache: u8g2 decodes every
+    // glyph of FONT_BN_TN, once per buffer pass of each frame
+    void frequencyBigU8g2(Bench::Firmware& fw, uint32_t i) {
+        uint32_t freq = FREQUENCIES[i % 4];
+        fw.ui.setFont(Font::FONT_BN_TN);
+        if (freq >= 100000000) {
+            fw.ui.drawText(TextAlign::RIGHT, 0, 111, 19, true, i & 4U, false, Fmt::dec(freq / 100000000), '.', Fmt::zero<3>((freq / 100000) % 1000), '.', Fmt::zero<3>((freq % 100000) / 100));
+        }
+        else if (freq >= 10000000) {
+            fw.ui.drawText(TextAlign::RIGHT, 0, 111, 19, true, i & 4U, false, Fmt::pad<3>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100));
+        }
+        else {
+            fw.ui.drawText(TextAlign::RIGHT, 0, 111, 19, true, i & 4U, false, Fmt::pad<2>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100));
+        }
+        fw.ui.setBlackColor();
+        fw.ui.setFont(Font::FONT_10_TR);
+        fw.ui.drawText(TextAlign::LEFT, 113, 0, 19, true, i & 4U, false, Fmt::zero<2>(freq % 100));
+    }
+
+    void frequencyBigCached(Bench::Firmware& fw, uint32_t i) {
+        fw.ui.drawFrequencyBig(i & 4U, FREQUENCIES[i % 4], 111, 19);
+    }
+
+    void mainVFOSetup(Bench::Firmware& fw) {
+        fw.mainVFO.init();
+    }
+
+    // Redraws the screen with nothing changed: only the hashes are checked
+    void mainVFOFrame(Bench::Firmware& fw, uint32_t) {
+        fw.mainVFO.drawScreen();
+    }
+
+    void press(Applications::Application& app, Keyboard::KeyCode key) {
+        app.action(key, Keyboard::KeyState::KEY_PRESSED);
+        app.action(key, Keyboard::KeyState::KEY_RELEASED);
+    }
+
+    // Tuning up and down a step: the big frequency digits change
+    void mainVFOTune(Bench::Firmware& fw, uint32_t i) {
+        press(fw.mainVFO, (i & 1U) ? Keyboard::KeyCode::KEY_DOWN : Keyboard::KeyCode::KEY_UP);
+        fw.mainVFO.drawScreen();
+    }
+
+    void menuSetup(Bench::Firmware& fw) {
+        fw.menu.init();
+    }
+
+    // Moving the selection one line down and back
+    void menuScroll(Bench::Firmware& fw, uint32_t i) {
+        press(fw.menu, (i & 1U) ? Keyboard::KeyCode::KEY_UP : Keyboard::KeyCode::KEY_DOWN);
+        fw.menu.drawScreen();
+    }
+
+    void messengerSetup(Bench::Firmware& fw) {
+        fw.messenger.init();
+    }
+
+    // Multi-tap on one key: the last character and the popup selection change
+    void messengerType(Bench::Firmware& fw, uint32_t) {
+        press(fw.messenger, Keyboard::KeyCode::KEY_2);
+        fw.messenger.drawScreen();
+    }
+
+    // One 100 ms app tick on an idle receiver, as the frame scheduler runs it
+    void mainVFOIdleTick(Bench::Firmware& fw, uint32_t) {
+        fw.mainVFO.update();
+        uint8_t regions = fw.mainVFO.takeInvalidRegions();
+        if (regions) {
+            fw.mainVFO.drawScreen(regions);
+        }
+    }
+
+} // namespace
+
+BENCH_CASE(ctcssLabel, "ui.codeLabel.ctcss", "call", 2000, nullptr, ctcssLabel);
+BENCH_CASE(dcsLabel, "ui.codeLabel.dcs", "call", 2000, nullptr, dcsLabel);
+BENCH_CASE(frequencyBigU8g2, "ui.frequencyBig.u8g2", "call", 2000, nullptr, frequencyBigU8g2);
+BENCH_CASE(frequencyBigCached, "ui.frequencyBig.cached", "call", 2000, nullptr, frequencyBigCached);
+BENCH_CASE(mainVFO, "mainvfo.drawScreen", "frame", 500, mainVFOSetup, mainVFOFrame);
+BENCH_CASE(mainVFOTune, "mainvfo.frame.tune", "frame", 500, mainVFOSetup, mainVFOTune);
+BENCH_CASE(menuScroll, "menu.frame.scroll", "frame", 500, menuSetup, menuScroll);
+BENCH_CASE(messengerType, "messenger.frame.type", "frame", 500, messengerSetup, messengerType);
+BENCH_CASE(mainVFOIdle, "mainvfo.update.idle", "tick", 500, mainVFOSetup, mainVFOIdleTick);
@@ -0,0 +1,22 @@
+#pragma once
+
+// Host build: the Cortex-M0 core peripherals used by the firmware. The NVIC
+// has nothing to gate on the host and SysTick is the simulated down-counter.
+
+#include <cstdint>
+
+#include "host_sim.h"
+
+typedef int IRQn_Type;
+
+static inline void NVIC_EnableIRQ(__attribute__((unused)) IRQn_Type IRQn) {}
+static inline void NVIC_DisableIRQ(__attribute__((unused)) IRQn_Type IRQn) {}
+static inline void NVIC_SetPriority(__attribute__((unused)) IRQn_Type IRQn, __attribute__((unused)) uint32_t priority) {}
+
+#define SysTick (&HostSim::sysTick)
+
+static inline uint32_t SysTick_Config(uint32_t ticks) {
+    SysTick->LOAD = ticks - 1U;
+    SysTick->CTRL = 7U;
+    return 0U;
+}
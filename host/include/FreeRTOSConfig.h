@@ -0,0 +1,22 @@
+#pragma once
+
+// Host build: the firmware configuration with the values the POSIX port needs.
+// Task stacks become pthread stacks, so the Cortex-M0 sizes are far too small.
+
+#include_next "FreeRTOSConfig.h"
+
+#undef configMINIMAL_STACK_SIZE
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)4096)
+
+#undef configTIMER_TASK_STACK_DEPTH
+#define configTIMER_TASK_STACK_DEPTH             4096
+
+#undef configMAX_TASK_NAME_LEN
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+
+#undef INCLUDE_xTaskGetSchedulerState
+#define INCLUDE_xTaskGetSchedulerState      1
+
+#undef configASSERT
+void vHostAssertCalled( unsigned long ulLine, const char * const pcFileName );
+#define configASSERT( x ) if( (x) == 0 ) vHostAssertCalled( __LINE__, __FILE__ )
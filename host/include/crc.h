@@ -0,0 +1,13 @@
+#pragma once
+
+// Host build: the CRC unit data registers are computed in software.
+
+#include_next "crc.h"
+
+#include "host_sim.h"
+
+#undef CRC_DATAIN
+#define CRC_DATAIN (HostSim::crcDataIn)
+
+#undef CRC_DATAOUT
+#define CRC_DATAOUT (HostSim::crcDataOut)
@@ -0,0 +1,50 @@
+#pragma once
+
+// Host build: wraps the firmware gpio_hal.h so that every pin access made
+// through it reaches the simulated peripherals. The pin enums and the raw
+// read-modify-write helpers come from the original header. The Makefile
+// force-includes this file, the drivers would find theirs first otherwise.
+
+#define GPIO_ClearBit HostGPIO_ClearBit
+#define GPIO_CheckBit HostGPIO_CheckBit
+#define GPIO_FlipBit HostGPIO_FlipBit
+#define GPIO_SetBit HostGPIO_SetBit
+#define GPIO_Write HostGPIO_Write
+#define GPIO_Wait HostGPIO_Wait
+#include "../../src/driver/gpio_hal.h"
+#undef GPIO_ClearBit
+#undef GPIO_CheckBit
+#undef GPIO_FlipBit
+#undef GPIO_SetBit
+#undef GPIO_Write
+#undef GPIO_Wait
+
+#include "host_sim.h"
+
+static inline void GPIO_ClearBit(volatile uint32_t* pReg, uint8_t Bit) {
+    HostGPIO_ClearBit(pReg, Bit);
+    HostSim::gpioWritten(pReg);
+}
+
+static inline uint8_t GPIO_CheckBit(volatile uint32_t* pReg, uint8_t Bit) {
+    return (uint8_t)((HostSim::gpioRead(pReg) >> Bit) & 1U);
+}
+
+static inline void GPIO_FlipBit(volatile uint32_t* pReg, uint8_t Bit) {
+    HostGPIO_FlipBit(pReg, Bit);
+    HostSim::gpioWritten(pReg);
+}
+
+static inline void GPIO_SetBit(volatile uint32_t* pReg, uint8_t Bit) {
+    HostGPIO_SetBit(pReg, Bit);
+    HostSim::gpioWritten(pReg);
+}
+
+static inline void GPIO_Write(volatile uint32_t* pReg, uint32_t Value) {
+    HostGPIO_Write(pReg, Value);
+    HostSim::gpioStored(pReg);
+}
+
+static inline void GPIO_Wait(const uint32_t Cycles) {
+    HostSim::gpioWait(Cycles);
+}
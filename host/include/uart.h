@@ -0,0 +1,12 @@
+#pragma once
+
+// Host build: UART1 points at a simulated register block whose TDR forwards
+// every transmitted byte to the host UART back end. RX still goes through the
+// DMA ring (UART_DMA_Buffer / DMA_CH0->ST), which the simulator fills.
+
+#include_next "uart.h"
+
+#include "host_sim.h"
+
+#undef UART1
+#define UART1 (&HostSim::uart1)
@@ -0,0 +1,219 @@
+/*
+ * Host port of the FreeRTOS kernel for the Linux simulation.
+ *
+ * Every task is a pthread, but only the thread whose TCB is pxCurrentTCB
+ * runs; the others wait on schedCond. A tick thread sends SIGALRM to the
+ * running task, which advances the kernel tick and switches context from
+ * the signal handler unless "interrupts" are masked, the same way the
+ * SysTick and PendSV handlers do on the Cortex-M0.
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Task stacks are not used, the thread state sits at the top of the buffer */
+typedef struct {
+    pthread_t tid;
+    TaskFunction_t fn;
+    void *arg;
+} Thread_t;
+
+extern void * volatile pxCurrentTCB;
+
+static __thread Thread_t *self;
+static pthread_mutex_t schedLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t schedCond = PTHREAD_COND_INITIALIZER;
+static volatile int started;
+static volatile int masked = 1;
+static volatile UBaseType_t nesting;
+static volatile int pendingYield;
+static atomic_int pendingTicks;
+
+/* pxTopOfStack is the first TCB member */
+static Thread_t *current(void) {
+    return pxCurrentTCB ? *(Thread_t **)pxCurrentTCB : NULL;
+}
+
+static void waitTurn(void) {
+    pthread_mutex_lock(&schedLock);
+    pthread_cond_broadcast(&schedCond);
+    while (!started || current() != self) {
+        pthread_cond_wait(&schedCond, &schedLock);
+    }
+    pthread_mutex_unlock(&schedLock);
+}
+
+static void doSwitch(void) {
+    vTaskSwitchContext();
+    if (current() != self) {
+        waitTurn();
+    }
+}
+
+static void serviceTicks(void) {
+    while (atomic_exchange(&pendingTicks, 0) > 0) {
+        if (xTaskIncrementTick()) {
+            pendingYield = 1;
+        }
+    }
+}
+
+static void runPending(void) {
+    while (!masked && nesting == 0 && (atomic_load(&pendingTicks) || pendingYield)) {
+        masked = 1;
+        serviceTicks();
+        if (pendingYield) {
+            pendingYield = 0;
+            doSwitch();
+        }
+        masked = 0;
+    }
+}
+
+static void onTick(int sig) {
+    (void)sig;
+    if (self && self == current()) {
+        runPending();
+    }
+}
+
+static void *threadMain(void *p) {
+    self = p;
+    waitTurn();
+
+    sigset_t s;
+    sigemptyset(&s);
+    sigaddset(&s, SIGALRM);
+    pthread_sigmask(SIG_UNBLOCK, &s, NULL);
+
+    nesting = 0;
+    masked = 0;
+    self->fn(self->arg);
+
+    for (;;) {
+        pause();
+    }
+    return NULL;
+}
+
+static void *tickThread(void *p) {
+    (void)p;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    for (;;) {
+        next.tv_nsec += 1000000000L / configTICK_RATE_HZ;
+        if (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        atomic_fetch_add(&pendingTicks, 1);
+
+        pthread_mutex_lock(&schedLock);
+        Thread_t *t = current();
+        if (t) {
+            pthread_kill(t->tid, SIGALRM);
+        }
+        pthread_mutex_unlock(&schedLock);
+    }
+    return NULL;
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters) {
+    Thread_t *t = (Thread_t *)(((uintptr_t)pxTopOfStack - sizeof(Thread_t)) & ~(uintptr_t)15);
+    t->fn = pxCode;
+    t->arg = pvParameters;
+
+    /* The new thread starts with every signal blocked until it runs */
+    sigset_t all, prev;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &prev);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 1 << 20);
+    pthread_create(&t->tid, &attr, threadMain, t);
+    pthread_attr_destroy(&attr);
+
+    pthread_sigmask(SIG_SETMASK, &prev, NULL);
+    return (StackType_t *)t;
+}
+
+void vPortYield(void) {
+    pendingYield = 1;
+    runPending();
+}
+
+void vPortDisableInterrupts(void) {
+    masked = 1;
+}
+
+void vPortEnableInterrupts(void) {
+    masked = 0;
+    runPending();
+}
+
+void vPortEnterCritical(void) {
+    masked = 1;
+    nesting++;
+}
+
+void vPortExitCritical(void) {
+    if (nesting && --nesting == 0) {
+        masked = 0;
+        runPending();
+    }
+}
+
+BaseType_t xPortSetInterruptMask(void) {
+    BaseType_t m = masked;
+    masked = 1;
+    return m;
+}
+
+void vPortClearInterruptMask(BaseType_t xMask) {
+    masked = (int)xMask;
+    if (!xMask) {
+        runPending();
+    }
+}
+
+BaseType_t xPortStartScheduler(void) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof sa);
+    sa.sa_handler = onTick;
+    sigfillset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &sa, NULL);
+
+    sigset_t all;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+    pthread_t tick;
+    pthread_create(&tick, NULL, tickThread, NULL);
+
+    pthread_mutex_lock(&schedLock);
+    started = 1;
+    pthread_cond_broadcast(&schedCond);
+    pthread_mutex_unlock(&schedLock);
+
+    for (;;) {
+        pause();
+    }
+    return 0;
+}
+
+void vPortEndScheduler(void) {
+    exit(0);
+}
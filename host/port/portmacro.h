@@ -0,0 +1,63 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/*
+ * Host port: FreeRTOS tasks run as pthreads, see port.c.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define portCHAR                    char
+#define portFLOAT                   float
+#define portDOUBLE                  double
+#define portLONG                    long
+#define portSHORT                   short
+#define portSTACK_TYPE              uintptr_t
+#define portBASE_TYPE               long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY               ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC     1
+
+#define portSTACK_GROWTH            ( -1 )
+#define portHAS_STACK_OVERFLOW_CHECKING 0
+#define portTICK_PERIOD_MS          ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT          8
+#define portPOINTER_SIZE_TYPE       uintptr_t
+#define portNOP()
+
+void vPortYield( void );
+void vPortDisableInterrupts( void );
+void vPortEnableInterrupts( void );
+void vPortEnterCritical( void );
+void vPortExitCritical( void );
+BaseType_t xPortSetInterruptMask( void );
+void vPortClearInterruptMask( BaseType_t xMask );
+
+#define portYIELD()                                 vPortYield()
+#define portEND_SWITCHING_ISR( x )                  do { if( x ) vPortYield(); } while( 0 )
+#define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
+
+#define portDISABLE_INTERRUPTS()                    vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()                     vPortEnableInterrupts()
+#define portENTER_CRITICAL()                        vPortEnterCritical()
+#define portEXIT_CRITICAL()                         vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()           xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )      vPortClearInterruptMask( x )
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )       void vFunction( void * pvParameters )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,130 @@
+#include "bk4819_model.h"
+
+#include <cstring>
+
+#include "bk4819-regs.h"
+
+namespace HostSim {
+
+    void BK4819Model::pins(bool scn, bool scl, bool sdaIn) {
+        if (scn) {
+            // Chip deselected, any partial transfer is dropped
+            lastScn = true;
+            lastScl = scl;
+            readPhase = false;
+            sdaOut = true;
+            return;
+        }
+
+        if (lastScn) {
+            // Falling SCN starts a new frame
+            lastScn = false;
+            bitCount = 0;
+            shift = 0;
+            readPhase = false;
+        }
+
+        bool rising = scl && !lastScl;
+        lastScl = scl;
+
+        if (!rising) {
+            return;
+        }
+
+        if (bitCount < 8) {
+            // Address byte, MSB first, bit 7 selects a read
+            shift = (uint16_t)((shift << 1) | (sdaIn ? 1U : 0U));
+            if (++bitCount == 8) {
+                address = (uint8_t)shift;
+                shift = 0;
+                if (address & 0x80) {
+                    shift = read(address & 0x7F);
+                    readPhase = true;
+                    sdaOut = (shift & 0x8000) != 0;
+                }
+            }
+            return;
+        }
+
+        if (readPhase) {
+            // The master samples before raising SCL, advance to the next bit
+            shift = (uint16_t)(shift << 1);
+            sdaOut = (shift & 0x8000) != 0;
+            if (++bitCount == 24) {
+                readPhase = false;
+                sdaOut = true;
+            }
+            return;
+        }
+
+        if (bitCount < 24) {
+            shift = (uint16_t)((shift << 1) | (sdaIn ? 1U : 0U));
+            if (++bitCount == 24) {
+                write(address & 0x7F, shift);
+            }
+        }
+    }
+
+    void BK4819Model::raiseInterrupt(uint16_t flags) {
+        flags &= regs[BK4819_REG_3F];
+        if (flags) {
+            pendingFlags.fetch_or(flags);
+        }
+    }
+
+    // "Squelch lost" is the squelch opening on a carrier, as the firmware
+    // reads it
+    void BK4819Model::setCarrier(bool on) {
+        if (carrier.exchange(on) != on) {
+            raiseInterrupt(on ? BK4819_REG_3F_SQUELCH_LOST : BK4819_REG_3F_SQUELCH_FOUND);
+        }
+    }
+
+    uint16_t BK4819Model::read(uint8_t reg) {
+        reads++;
+        switch (reg) {
+        case BK4819_REG_02:
+            return latchedFlags;
+        case BK4819_REG_0C:
+            return (uint16_t)((pendingFlags.load() ? 1U : 0U) | (carrier ? 2U : 0U));
+        case BK4819_REG_63:
+            return carrier ? 0x0004 : 0x0060;
+        case BK4819_REG_65:
+            return carrier ? 0x5A08 : 0x0C48;
+        case BK4819_REG_67:
+            // RSSI is reported in 0.5 dB steps from -160 dBm
+            return carrier ? (uint16_t)((160 - 60) * 2) : (uint16_t)((160 - 125) * 2);
+        default:
+            return regs[reg];
+        }
+    }
+
+    void BK4819Model::write(uint8_t reg, uint16_t value) {
+        writes++;
+        switch (reg) {
+        case BK4819_REG_00:
+            if (value & 0x8000) {
+                memset(regs, 0, sizeof(regs));
+                pendingFlags = 0;
+                latchedFlags = 0;
+            }
+            break;
+        case BK4819_REG_02:
+            // Writing REG_02 acknowledges the IRQ and latches the flags for reading
+            latchedFlags = pendingFlags.exchange(0);
+            return;
+        case BK4819_REG_59:
+            // FSK TX enable, the packet leaves instantly in the model
+            if ((value & (1U << 11)) && !(regs[BK4819_REG_59] & (1U << 11))) {
+                regs[reg] = value;
+                raiseInterrupt(BK4819_REG_3F_FSK_TX_FINISHED);
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        regs[reg] = value;
+    }
+
+} // namespace HostSim
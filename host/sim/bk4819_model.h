@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace HostSim {
+
+    // BK4819 register model behind the 3-wire bit-banged bus (SCN/SCL/SDA).
+    // Registers are plain storage except for the handful the firmware polls:
+    // 0x02 (latched interrupt flags), 0x0C (IRQ / squelch status),
+    // 0x63/0x65/0x67 (glitch, noise, RSSI) and the FSK TX trigger in 0x59.
+    class BK4819Model {
+    public:
+
+        // Master pin levels after every write to GPIOC->DATA
+        void pins(bool scn, bool scl, bool sda);
+
+        // Level the chip drives on SDA while a register is clocked out
+        bool sda(void) const { return readPhase ? sdaOut : true; }
+
+        uint16_t peek(uint8_t reg) const { return regs[reg & 0x7F]; }
+
+        // Raise interrupt flags (REG_3F layout), masked by the enabled sources
+        void raiseInterrupt(uint16_t flags);
+
+        // Simulated on-air signal, toggles squelch found / lost
+        void setCarrier(bool on);
+        bool hasCarrier(void) const { return carrier; }
+
+        uint32_t getWriteCount(void) const { return writes; }
+        uint32_t getReadCount(void) const { return reads; }
+
+    private:
+
+        uint16_t regs[128] = {};
+        uint16_t latchedFlags = 0;
+        std::atomic<uint16_t> pendingFlags{ 0 };
+        std::atomic<bool> carrier{ false };
+
+        // Pin decoder state
+        bool lastScn = true;
+        bool lastScl = true;
+        bool readPhase = false;
+        bool sdaOut = true;
+        uint8_t bitCount = 0;
+        uint8_t address = 0;
+        uint16_t shift = 0;
+
+        uint32_t writes = 0;
+        uint32_t reads = 0;
+
+        uint16_t read(uint8_t reg);
+        void write(uint8_t reg, uint16_t value);
+    };
+
+} // namespace HostSim
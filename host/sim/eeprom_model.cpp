@@ -0,0 +1,201 @@
+#include "eeprom_model.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_sim.h"
+
+namespace HostSim {
+
+    bool EEPROMModel::open(const char* path) {
+        memset(memory, 0xFF, sizeof(memory));
+
+        if (!path) {
+            return true;
+        }
+
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+
+        ssize_t got = pread(fd, memory, sizeof(memory), 0);
+        if (got < (ssize_t)sizeof(memory)) {
+            // New or short image, pad it out as erased memory
+            if (pwrite(fd, memory, sizeof(memory), 0) != (ssize_t)sizeof(memory)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void EEPROMModel::pins(bool scl, bool sda) {
+        if (scl && lastScl && sda != lastSda) {
+            // SDA moving while SCL is high is a START or a STOP
+            lastSda = sda;
+            if (!sda) {
+                start();
+            }
+            else {
+                stop();
+            }
+            return;
+        }
+
+        bool rising = scl && !lastScl;
+        bool falling = !scl && lastScl;
+        lastScl = scl;
+        lastSda = sda;
+
+        if (state == State::IDLE || state == State::IGNORE) {
+            return;
+        }
+
+        if (state == State::READ) {
+            if (rising) {
+                if (ackSlot) {
+                    masterAck = !sda;
+                    bitCount = 9;
+                }
+                else {
+                    bitCount++;
+                }
+            }
+            else if (falling) {
+                if (!ackSlot) {
+                    if (bitCount == 8) {
+                        // Release SDA for the master ACK / NACK
+                        sdaOut = true;
+                        ackSlot = true;
+                    }
+                    else {
+                        sdaOut = (shift & (0x80U >> bitCount)) != 0;
+                    }
+                }
+                else if (bitCount == 9) {
+                    ackSlot = false;
+                    if (masterAck) {
+                        address = (uint16_t)((address + 1) % SIZE);
+                        loadTransmit();
+                    }
+                    else {
+                        sdaOut = true;
+                        state = State::IGNORE;
+                    }
+                }
+            }
+            return;
+        }
+
+        if (rising) {
+            if (ackSlot) {
+                bitCount = 9;
+            }
+            else if (bitCount < 8) {
+                shift = (uint8_t)((shift << 1) | (sda ? 1U : 0U));
+                bitCount++;
+            }
+        }
+        else if (falling) {
+            if (!ackSlot) {
+                if (bitCount == 8) {
+                    ackSlot = true;
+                    sdaOut = !receive(shift);
+                }
+            }
+            else if (bitCount == 9) {
+                ackSlot = false;
+                sdaOut = true;
+                bitCount = 0;
+                shift = 0;
+                if (state == State::READ_START) {
+                    state = State::READ;
+                    loadTransmit();
+                }
+            }
+        }
+    }
+
+    void EEPROMModel::start(void) {
+        if (state == State::WRITE && pageMask) {
+            commitPage();
+        }
+        state = State::DEVICE;
+        bitCount = 0;
+        shift = 0;
+        ackSlot = false;
+        sdaOut = true;
+    }
+
+    void EEPROMModel::stop(void) {
+        if (state == State::WRITE && pageMask) {
+            commitPage();
+        }
+        state = State::IDLE;
+        ackSlot = false;
+        sdaOut = true;
+    }
+
+    bool EEPROMModel::receive(uint8_t byte) {
+        switch (state) {
+        case State::DEVICE:
+            if ((byte & 0xFE) != DEVICE_ADDRESS || nowNs() < busyUntilNs) {
+                // Not addressed, or still inside the internal write cycle
+                state = State::IGNORE;
+                return false;
+            }
+            state = (byte & 0x01) ? State::READ_START : State::ADDRESS_HIGH;
+            return true;
+
+        case State::ADDRESS_HIGH:
+            address = (uint16_t)((byte & 0x1F) << 8);
+            state = State::ADDRESS_LOW;
+            return true;
+
+        case State::ADDRESS_LOW:
+            address = (uint16_t)(address | byte);
+            pageBase = (uint16_t)(address & ~(PAGE_SIZE - 1));
+            pageMask = 0;
+            state = State::WRITE;
+            return true;
+
+        case State::WRITE: {
+            // Data rolls over inside the 32-byte page, as on the real part
+            uint8_t offset = (uint8_t)(address % PAGE_SIZE);
+            page[offset] = byte;
+            pageMask |= 1UL << offset;
+            address = (uint16_t)(pageBase | ((offset + 1) % PAGE_SIZE));
+            return true;
+        }
+
+        default:
+            return false;
+        }
+    }
+
+    void EEPROMModel::loadTransmit(void) {
+        shift = memory[address];
+        bitCount = 0;
+        sdaOut = (shift & 0x80) != 0;
+    }
+
+    void EEPROMModel::commitPage(void) {
+        for (uint8_t i = 0; i < PAGE_SIZE; i++) {
+            if (pageMask & (1UL << i)) {
+                memory[pageBase + i] = page[i];
+            }
+        }
+        pageMask = 0;
+        pageWrites++;
+        busyUntilNs = nowNs() + writeCycleNs;
+
+        if (fd >= 0) {
+            if (pwrite(fd, memory + pageBase, PAGE_SIZE, pageBase) != PAGE_SIZE) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+} // namespace HostSim
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+namespace HostSim {
+
+    // 24C64 (8 KB, 32-byte pages) behind the bit-banged I2C bus on GPIOA 10/11,
+    // backed by an image file that is written through on every page commit.
+    class EEPROMModel {
+    public:
+        static constexpr uint16_t SIZE = 0x2000;
+        static constexpr uint16_t PAGE_SIZE = 32;
+        static constexpr uint8_t DEVICE_ADDRESS = 0xA0;
+
+        // Loads the image, a missing file starts as an erased (0xFF) part and
+        // no path keeps the part in memory only
+        bool open(const char* path);
+
+        // Master pin levels after every write to GPIOA->DATA
+        void pins(bool scl, bool sda);
+
+        // Level the part drives on SDA (open drain, true = released)
+        bool sda(void) const { return sdaOut; }
+
+        // Internal write cycle time, 0 keeps the part always ready
+        void setWriteCycleTime(uint32_t us) { writeCycleNs = (uint64_t)us * 1000U; }
+
+        const uint8_t* data(void) const { return memory; }
+
+        uint32_t getPageWriteCount(void) const { return pageWrites; }
+
+    private:
+        enum class State : uint8_t {
+            IDLE,
+            DEVICE,         // receiving the device address byte
+            ADDRESS_HIGH,
+            ADDRESS_LOW,
+            WRITE,          // receiving data bytes
+            READ_START,     // read addressed, ACK in progress
+            READ,           // transmitting data bytes
+            IGNORE          // not addressed / NACKed
+        };
+
+        uint8_t memory[SIZE];
+        uint8_t page[PAGE_SIZE];
+        uint32_t pageMask = 0;
+        uint16_t pageBase = 0;
+
+        int fd = -1;
+
+        State state = State::IDLE;
+        bool lastScl = true;
+        bool lastSda = true;
+        bool sdaOut = true;
+        bool ackSlot = false;
+        bool masterAck = false;
+        uint8_t bitCount = 0;
+        uint8_t shift = 0;
+        uint16_t address = 0;
+
+        uint64_t writeCycleNs = 0;
+        uint64_t busyUntilNs = 0;
+        uint32_t pageWrites = 0;
+
+        void start(void);
+        void stop(void);
+        bool receive(uint8_t byte);
+        void loadTransmit(void);
+        void commitPage(void);
+    };
+
+} // namespace HostSim
@@ -0,0 +1,571 @@
+#include "host_sim.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "gpio.h"
+#include "gpio_hal.h"
+#include "dma.h"
+#include "crc.h"
+#include "aes.h"
+#include "saradc.h"
+#include "keyboard.h"
+
+#include "bk4819_model.h"
+#include "eeprom_model.h"
+#include "st7565_model.h"
+
+// Owned by src/init.cpp on the target, which is not part of the host build
+uint8_t UART_DMA_Buffer[256];
+
+extern "C" void vHostAssertCalled(unsigned long ulLine, const char* const pcFileName) {
+    fprintf(stderr, "[host] assert failed: %s:%lu\n", pcFileName, ulLine);
+    abort();
+}
+
+namespace HostSim {
+
+    __attribute__((weak)) bool headless = false;
+
+    volatile UartPort uart1;
+    volatile SysTickPort sysTick;
+    volatile CrcDataIn crcDataIn;
+    volatile CrcDataOut crcDataOut;
+
+    namespace {
+
+        // All DP32G030 peripherals live in this window
+        constexpr uintptr_t PERIPHERAL_BASE = 0x40000000U;
+        constexpr size_t PERIPHERAL_SIZE = 0x00100000U;
+
+        constexpr uint32_t KEY_SHORT_MS = 120;
+        constexpr uint32_t KEY_LONG_MS = 1000;
+        constexpr uint32_t KEY_PTT_MS = 3000;
+        constexpr uint32_t SCREEN_PERIOD_MS = 50;
+
+        // Raw battery ADC reading, ~8.0 V with the default calibration
+        constexpr uint16_t BATTERY_ADC = 1973;
+
+        // Constructed ahead of hostSimInit(), which opens and starts them
+        __attribute__((init_priority(101))) BK4819Model bk4819Model;
+        __attribute__((init_priority(101))) EEPROMModel eepromModel;
+        __attribute__((init_priority(101))) ST7565Model displayModel;
+
+        const char* screenPath = "screen.pbm";
+
+        int uartRxFd = -1;
+        int uartTxFd = -1;
+        int keysFd = -1;
+        uint16_t uartRxIndex = 0;
+
+        uint16_t crcValue = 0;
+
+        BusCounters counters = {};
+        bool virtualTime = false;
+        uint32_t sysTickPhase = 0;
+
+        TraceMode traceMode = TraceMode::OFF;
+        uint32_t* traceBuffer = nullptr;
+        size_t traceCapacity = 0;
+        size_t tracePosition = 0;
+
+        std::atomic<uint8_t> pressedKey{ (uint8_t)Keyboard::KeyCode::KEY_INVALID };
+        std::atomic<uint64_t> releaseAtNs{ 0 };
+
+        struct termios savedTermios;
+        bool termiosSaved = false;
+
+        // Keypad matrix: column inputs on GPIOA 3..6, rows driven low on
+        // GPIOA 10..13; row 0 keys are wired straight to ground.
+        struct KeyWiring {
+            Keyboard::KeyCode key;
+            uint8_t row;
+            uint8_t column;
+        };
+
+        constexpr KeyWiring keyWiring[] = {
+            { Keyboard::KeyCode::KEY_SIDE1, 0, GPIOA_PIN_KEYBOARD_0 },
+            { Keyboard::KeyCode::KEY_SIDE2, 0, GPIOA_PIN_KEYBOARD_1 },
+            { Keyboard::KeyCode::KEY_MENU,  GPIOA_PIN_KEYBOARD_4, GPIOA_PIN_KEYBOARD_0 },
+            { Keyboard::KeyCode::KEY_1,     GPIOA_PIN_KEYBOARD_4, GPIOA_PIN_KEYBOARD_1 },
+            { Keyboard::KeyCode::KEY_4,     GPIOA_PIN_KEYBOARD_4, GPIOA_PIN_KEYBOARD_2 },
+            { Keyboard::KeyCode::KEY_7,     GPIOA_PIN_KEYBOARD_4, GPIOA_PIN_KEYBOARD_3 },
+            { Keyboard::KeyCode::KEY_UP,    GPIOA_PIN_KEYBOARD_5, GPIOA_PIN_KEYBOARD_0 },
+            { Keyboard::KeyCode::KEY_2,     GPIOA_PIN_KEYBOARD_5, GPIOA_PIN_KEYBOARD_1 },
+            { Keyboard::KeyCode::KEY_5,     GPIOA_PIN_KEYBOARD_5, GPIOA_PIN_KEYBOARD_2 },
+            { Keyboard::KeyCode::KEY_8,     GPIOA_PIN_KEYBOARD_5, GPIOA_PIN_KEYBOARD_3 },
+            { Keyboard::KeyCode::KEY_DOWN,  GPIOA_PIN_KEYBOARD_6, GPIOA_PIN_KEYBOARD_0 },
+            { Keyboard::KeyCode::KEY_3,     GPIOA_PIN_KEYBOARD_6, GPIOA_PIN_KEYBOARD_1 },
+            { Keyboard::KeyCode::KEY_6,     GPIOA_PIN_KEYBOARD_6, GPIOA_PIN_KEYBOARD_2 },
+            { Keyboard::KeyCode::KEY_9,     GPIOA_PIN_KEYBOARD_6, GPIOA_PIN_KEYBOARD_3 },
+            { Keyboard::KeyCode::KEY_EXIT,  GPIOA_PIN_KEYBOARD_7, GPIOA_PIN_KEYBOARD_0 },
+            { Keyboard::KeyCode::KEY_STAR,  GPIOA_PIN_KEYBOARD_7, GPIOA_PIN_KEYBOARD_1 },
+            { Keyboard::KeyCode::KEY_0,     GPIOA_PIN_KEYBOARD_7, GPIOA_PIN_KEYBOARD_2 },
+            { Keyboard::KeyCode::KEY_F,     GPIOA_PIN_KEYBOARD_7, GPIOA_PIN_KEYBOARD_3 },
+        };
+
+        constexpr uint32_t KEY_COLUMNS_MASK =
+            (1U << GPIOA_PIN_KEYBOARD_0) |
+            (1U << GPIOA_PIN_KEYBOARD_1) |
+            (1U << GPIOA_PIN_KEYBOARD_2) |
+            (1U << GPIOA_PIN_KEYBOARD_3);
+
+        uint32_t sysTickReload(void) {
+            uint32_t reload = sysTick.LOAD + 1U;
+            return reload > 1U ? reload : 0x01000000U;
+        }
+
+        // Charges target cycles, the SysTick phase follows them so that a
+        // virtual time poll needs no division
+        void advance(uint32_t cycles) {
+            counters.cycles += cycles;
+            sysTickPhase += cycles;
+            uint32_t reload = sysTickReload();
+            if (sysTickPhase >= reload) {
+                sysTickPhase %= reload;
+            }
+        }
+
+        Keyboard::KeyCode currentKey(void) {
+            if (nowNs() >= releaseAtNs.load()) {
+                return Keyboard::KeyCode::KEY_INVALID;
+            }
+            return (Keyboard::KeyCode)pressedKey.load();
+        }
+
+        void settleInputs(void) {
+            Keyboard::KeyCode key = currentKey();
+            uint32_t data = GPIOA->DATA;
+            uint32_t low = 0;
+
+            if (key != Keyboard::KeyCode::KEY_INVALID) {
+                for (const KeyWiring& wire : keyWiring) {
+                    if (wire.key == key && (wire.row == 0 || !(data & (1U << wire.row)))) {
+                        low |= 1U << wire.column;
+                    }
+                }
+            }
+
+            uint32_t settled = (data | KEY_COLUMNS_MASK) & ~low;
+            if (settled != data) {
+                GPIOA->DATA = settled;
+            }
+        }
+
+        // Key script characters: lower case is a short press, upper case a
+        // long press, '.' waits half a second and 'c' toggles a carrier.
+        bool keyFromChar(char c, Keyboard::KeyCode& key, uint32_t& holdMs) {
+            holdMs = KEY_SHORT_MS;
+            if (c >= '0' && c <= '9') {
+                key = (Keyboard::KeyCode)(c - '0');
+                return true;
+            }
+            if (c >= 'A' && c <= 'Z') {
+                holdMs = KEY_LONG_MS;
+                c = (char)(c - 'A' + 'a');
+            }
+            switch (c) {
+            case 'm': case '\n': key = Keyboard::KeyCode::KEY_MENU; return true;
+            case 'u': key = Keyboard::KeyCode::KEY_UP; return true;
+            case 'd': key = Keyboard::KeyCode::KEY_DOWN; return true;
+            case 'x': key = Keyboard::KeyCode::KEY_EXIT; return true;
+            case '*': key = Keyboard::KeyCode::KEY_STAR; return true;
+            case 'f': case '#': key = Keyboard::KeyCode::KEY_F; return true;
+            case '[': key = Keyboard::KeyCode::KEY_SIDE1; return true;
+            case ']': key = Keyboard::KeyCode::KEY_SIDE2; return true;
+            case 'p':
+                key = Keyboard::KeyCode::KEY_PTT;
+                holdMs = KEY_PTT_MS;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        void sleepMs(uint32_t ms) {
+            struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000L };
+            while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+            }
+        }
+
+        void* uartRxThread(void*) {
+            uint8_t buffer[64];
+            struct pollfd pfd = { uartRxFd, POLLIN, 0 };
+
+            for (;;) {
+                if (poll(&pfd, 1, -1) < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    break;
+                }
+
+                ssize_t got = read(uartRxFd, buffer, sizeof(buffer));
+                if (got <= 0) {
+                    if (got < 0 && (errno == EINTR || errno == EAGAIN || errno == EIO)) {
+                        // EIO: no client on the pty yet
+                        sleepMs(20);
+                        continue;
+                    }
+                    break;
+                }
+
+                uartReceive(buffer, (uint16_t)got);
+            }
+            return nullptr;
+        }
+
+        void* keysThread(void*) {
+            char c;
+            for (;;) {
+                ssize_t got = read(keysFd, &c, 1);
+                if (got <= 0) {
+                    if (got < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    break;
+                }
+
+                Keyboard::KeyCode key;
+                uint32_t holdMs;
+                if (c == '.') {
+                    sleepMs(500);
+                }
+                else if (c == 'c') {
+                    bk4819Model.setCarrier(!bk4819Model.hasCarrier());
+                }
+                else if (keyFromChar(c, key, holdMs)) {
+                    pressKey((uint8_t)key, holdMs);
+                    // Leave room for the release to be scanned before the next key
+                    sleepMs(holdMs + 100);
+                }
+            }
+            return nullptr;
+        }
+
+        void restoreTerminal(void) {
+            if (termiosSaved) {
+                tcsetattr(STDIN_FILENO, TCSANOW, &savedTermios);
+            }
+        }
+
+        void onTerminate(int) {
+            restoreTerminal();
+            _exit(0);
+        }
+
+        void* screenThread(void*) {
+            // The only sim thread that takes Ctrl-C, the FreeRTOS threads block it
+            sigset_t signals;
+            sigemptyset(&signals);
+            sigaddset(&signals, SIGINT);
+            sigaddset(&signals, SIGTERM);
+            pthread_sigmask(SIG_UNBLOCK, &signals, nullptr);
+
+            for (;;) {
+                displayModel.dump(screenPath);
+                sleepMs(SCREEN_PERIOD_MS);
+            }
+            return nullptr;
+        }
+
+        bool openUart(const char* mode) {
+            if (mode && strcmp(mode, "stdio") == 0) {
+                uartRxFd = STDIN_FILENO;
+                uartTxFd = STDOUT_FILENO;
+                fprintf(stderr, "[host] UART1 on stdin/stdout\n");
+                return true;
+            }
+
+            int master = posix_openpt(O_RDWR | O_NOCTTY);
+            if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+                return false;
+            }
+
+            // Keep the slave open in raw mode so the pty survives clients coming
+            // and going, and never block the firmware when nobody is listening.
+            const char* slaveName = ptsname(master);
+            int slave = open(slaveName, O_RDWR | O_NOCTTY);
+            if (slave >= 0) {
+                struct termios tio;
+                tcgetattr(slave, &tio);
+                cfmakeraw(&tio);
+                cfsetspeed(&tio, B38400);
+                tcsetattr(slave, TCSANOW, &tio);
+            }
+            fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+            uartRxFd = master;
+            uartTxFd = master;
+            fprintf(stderr, "[host] UART1 on %s\n", slaveName);
+            return true;
+        }
+
+        void openKeys(const char* path, bool stdinFree) {
+            if (path) {
+                keysFd = open(path, O_RDWR);
+            }
+            else if (stdinFree) {
+                keysFd = STDIN_FILENO;
+                if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &savedTermios) == 0) {
+                    struct termios tio = savedTermios;
+                    tio.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+                    tcsetattr(STDIN_FILENO, TCSANOW, &tio);
+                    termiosSaved = true;
+                    atexit(restoreTerminal);
+                }
+            }
+            if (keysFd >= 0) {
+                fprintf(stderr, "[host] keys: 0-9 m u d x * f [ ] p (upper case = long), c = carrier\n");
+            }
+        }
+
+        void startThread(void* (*entry)(void*)) {
+            pthread_t thread;
+            pthread_create(&thread, nullptr, entry, nullptr);
+            pthread_detach(thread);
+        }
+
+        // Runs before main(), the firmware touches the registers right away
+        __attribute__((constructor(102))) void hostSimInit(void) {
+            void* window = mmap((void*)PERIPHERAL_BASE, PERIPHERAL_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+            if (window != (void*)PERIPHERAL_BASE) {
+                fprintf(stderr, "[host] cannot map the peripheral window at %p\n", (void*)PERIPHERAL_BASE);
+                exit(1);
+            }
+
+            // Inputs idle high (keypad pull-ups, PTT released), conversions done
+            GPIOA->DATA = KEY_COLUMNS_MASK;
+            GPIOC->DATA = 1U << GPIOC_PIN_PTT;
+
+            volatile ADC_Channel_t* channels = (volatile ADC_Channel_t*)&SARADC_CH0;
+            channels[4].STAT = ADC_CHx_STAT_EOC_BITS_COMPLETE;
+            channels[4].DATA = BATTERY_ADC;
+            channels[9].STAT = ADC_CHx_STAT_EOC_BITS_COMPLETE;
+            channels[9].DATA = 0;
+            AES_SR = AES_SR_CCF_BITS_COMPLETE;
+
+            const char* eepromPath = getenv("UVK_EEPROM");
+            if (!eepromPath && !headless) {
+                eepromPath = "eeprom.bin";
+            }
+            if (!eepromModel.open(eepromPath)) {
+                fprintf(stderr, "[host] cannot open EEPROM image %s\n", eepromPath);
+                exit(1);
+            }
+            if (const char* twr = getenv("UVK_EEPROM_TWR_US")) {
+                eepromModel.setWriteCycleTime((uint32_t)strtoul(twr, nullptr, 0));
+            }
+
+            if (headless) {
+                return;
+            }
+            fprintf(stderr, "[host] EEPROM image %s\n", eepromPath);
+
+            if (const char* path = getenv("UVK_SCREEN")) {
+                screenPath = path;
+            }
+            fprintf(stderr, "[host] screen dump %s\n", screenPath);
+
+            const char* uartMode = getenv("UVK_UART");
+            if (!openUart(uartMode)) {
+                fprintf(stderr, "[host] cannot open a pty for UART1\n");
+                exit(1);
+            }
+            openKeys(getenv("UVK_KEYS"), uartRxFd != STDIN_FILENO);
+
+            // Sim threads must never take the FreeRTOS port signals
+            sigset_t all, previous;
+            sigfillset(&all);
+            pthread_sigmask(SIG_SETMASK, &all, &previous);
+
+            startThread(uartRxThread);
+            if (keysFd >= 0) {
+                startThread(keysThread);
+            }
+            startThread(screenThread);
+
+            pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+
+            signal(SIGINT, onTerminate);
+            signal(SIGTERM, onTerminate);
+        }
+
+        void pinsWritten(volatile uint32_t* pReg, uint32_t cycles) {
+            counters.gpioWrites++;
+            advance(cycles);
+
+            if (traceMode == TraceMode::REPLAY) {
+                return;
+            }
+
+            if (pReg == &GPIOC->DATA) {
+                uint32_t data = *pReg;
+                bk4819Model.pins((data >> GPIOC_PIN_BK4819_SCN) & 1U,
+                    (data >> GPIOC_PIN_BK4819_SCL) & 1U,
+                    (data >> GPIOC_PIN_BK4819_SDA) & 1U);
+            }
+            else if (pReg == &GPIOA->DATA) {
+                uint32_t data = *pReg;
+                eepromModel.pins((data >> GPIOA_PIN_I2C_SCL) & 1U, (data >> GPIOA_PIN_I2C_SDA) & 1U);
+            }
+        }
+
+    } // namespace
+
+    uint64_t nowNs(void) {
+        if (virtualTime) {
+            return counters.cycles * 1000U / CPU_CLOCK_MHZ;
+        }
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    }
+
+    const BusCounters& busCounters(void) {
+        return counters;
+    }
+
+    void setVirtualTime(bool enabled) {
+        virtualTime = enabled;
+    }
+
+    BK4819Model& bk4819(void) {
+        return bk4819Model;
+    }
+
+    EEPROMModel& eeprom(void) {
+        return eepromModel;
+    }
+
+    ST7565Model& display(void) {
+        return displayModel;
+    }
+
+    void pressKey(uint8_t keyCode, uint32_t holdMs) {
+        pressedKey = keyCode;
+        releaseAtNs = nowNs() + (uint64_t)holdMs * 1000000ULL;
+    }
+
+    void gpioWritten(volatile uint32_t* pReg) {
+        pinsWritten(pReg, GPIO_WRITE_CYCLES);
+    }
+
+    void gpioStored(volatile uint32_t* pReg) {
+        pinsWritten(pReg, GPIO_STORE_CYCLES);
+    }
+
+    void gpioWait(uint32_t cycles) {
+        advance(cycles);
+    }
+
+    uint32_t gpioRead(volatile uint32_t* pReg) {
+        counters.gpioReads++;
+        advance(GPIO_READ_CYCLES);
+
+        if (traceMode == TraceMode::REPLAY) {
+            return tracePosition < traceCapacity ? traceBuffer[tracePosition++] : *pReg;
+        }
+
+        uint32_t value = *pReg;
+
+        if (pReg == &GPIOC->DATA) {
+            if (currentKey() == Keyboard::KeyCode::KEY_PTT) {
+                value &= ~(1U << GPIOC_PIN_PTT);
+            }
+            else {
+                value |= 1U << GPIOC_PIN_PTT;
+            }
+            // SDA turned around to input while the BK4819 clocks a register out
+            if (!(GPIOC->DIR & (1U << GPIOC_PIN_BK4819_SDA))) {
+                value &= ~(1U << GPIOC_PIN_BK4819_SDA);
+                value |= (bk4819Model.sda() ? 1U : 0U) << GPIOC_PIN_BK4819_SDA;
+            }
+        }
+        else if (pReg == &GPIOA->DATA) {
+            // Open drain: the EEPROM can only pull the line low
+            bool sda = eepromModel.sda();
+            if (GPIOA->DIR & (1U << GPIOA_PIN_I2C_SDA)) {
+                sda = sda && (value & (1U << GPIOA_PIN_I2C_SDA));
+            }
+            value &= ~(1U << GPIOA_PIN_I2C_SDA);
+            value |= (sda ? 1U : 0U) << GPIOA_PIN_I2C_SDA;
+        }
+
+        if (traceMode == TraceMode::RECORD && tracePosition < traceCapacity) {
+            traceBuffer[tracePosition++] = value;
+        }
+        return value;
+    }
+
+    void setReadTrace(TraceMode mode, uint32_t* buffer, size_t capacity) {
+        traceMode = mode;
+        traceBuffer = buffer;
+        traceCapacity = capacity;
+        tracePosition = 0;
+    }
+
+    size_t getReadTracePosition(void) {
+        return tracePosition;
+    }
+
+    void uartReceive(const uint8_t* data, uint16_t size) {
+        // Same ring the UART1 RX DMA channel loops over
+        for (uint16_t i = 0; i < size; i++) {
+            UART_DMA_Buffer[uartRxIndex] = data[i];
+            uartRxIndex = (uint16_t)((uartRxIndex + 1) % sizeof(UART_DMA_Buffer));
+        }
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        DMA_CH0->ST = uartRxIndex;
+    }
+
+    void uartTransmit(uint8_t byte) {
+        if (uartTxFd >= 0) {
+            // Dropped when a pty client is not draining it, like a floating TX line
+            if (write(uartTxFd, &byte, 1) < 0) {
+                return;
+            }
+        }
+    }
+
+    SysTickValue::operator uint32_t() const volatile {
+        if (traceMode != TraceMode::REPLAY) {
+            settleInputs();
+        }
+        counters.sysTickReads++;
+        advance(SYSTICK_POLL_CYCLES);
+
+        uint32_t reload = sysTickReload();
+        if (virtualTime) {
+            return reload - 1U - sysTickPhase;
+        }
+        uint64_t ticks = nowNs() * CPU_CLOCK_MHZ / 1000U;
+        return (uint32_t)(reload - 1U - (uint32_t)(ticks % reload));
+    }
+
+    void CrcDataIn::operator=(uint32_t value) volatile {
+        crcValue = (uint16_t)(crcValue ^ ((value & 0xFFU) << 8));
+        for (uint8_t i = 0; i < 8; i++) {
+            crcValue = (crcValue & 0x8000U) ? (uint16_t)((crcValue << 1) ^ 0x1021U) : (uint16_t)(crcValue << 1);
+        }
+    }
+
+    CrcDataOut::operator uint32_t() const volatile {
+        uint16_t result = crcValue;
+        crcValue = (uint16_t)CRC_IV;
+        return result;
+    }
+
+} // namespace HostSim
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Host (Linux) simulation of the UV-K5 board.
+//
+// The firmware sources are built unmodified against the FreeRTOS POSIX port,
+// only u8g2_hal.cpp is swapped for the host one. Every peripheral register
+// block is backed by plain memory mapped at its hardware address, and the
+// buses the firmware bit-bangs are decoded at pin level by the models below,
+// so the real drivers run on top of them:
+//
+//   GPIOC 0..2  -> BK4819 register model      (bk4819_model.h)
+//   GPIOA 10/11 -> 24C64 8 KB EEPROM model     (eeprom_model.h)
+//   UART1       -> pty (default) or stdin/stdout
+//   SPI0        -> ST7565 model, dumped as PBM (u8g2_hal.cpp)
+//   GPIOA 3..6  -> keypad matrix, GPIOC 5 -> PTT
+//   SysTick     -> 48 MHz down-counter in host time, so delays are real
+//   CRC         -> software CRC-16/CCITT
+//
+// Runtime configuration is read from the environment:
+//   UVK_EEPROM   EEPROM image path           (default eeprom.bin)
+//   UVK_SCREEN   PBM screen dump path         (default screen.pbm)
+//   UVK_UART     "pty" or "stdio"             (default pty)
+//   UVK_KEYS     key script / FIFO path       (default stdin, if free)
+//
+// Front ends that drive the firmware objects themselves (host/bench) set
+// HostSim::headless: no UART, keypad or screen threads, and the EEPROM is
+// kept in memory unless UVK_EEPROM names an image.
+
+namespace HostSim {
+
+    class BK4819Model;
+    class EEPROMModel;
+    class ST7565Model;
+
+    // Defined weak as false, a definition in the front end overrides it
+    extern bool headless;
+
+    // GPIO hooks used by the host gpio_hal.h
+    void gpioWritten(volatile uint32_t* pReg);
+    void gpioStored(volatile uint32_t* pReg);
+    uint32_t gpioRead(volatile uint32_t* pReg);
+    void gpioWait(uint32_t cycles);
+
+    // UART1 transmit path used by the host uart.h
+    void uartTransmit(uint8_t byte);
+
+    // Keypad / PTT injection, keyCode is a Keyboard::KeyCode value
+    void pressKey(uint8_t keyCode, uint32_t holdMs);
+
+    // UART1 receive path, bytes land in the RX DMA ring
+    void uartReceive(const uint8_t* data, uint16_t size);
+
+    // Monotonic host time, used for delays and model timing. In virtual time
+    // it is the modeled target time instead, see setVirtualTime().
+    uint64_t nowNs(void);
+
+    // Bus accounting. Every pin access made through gpio_hal.h and every
+    // SysTick VAL poll is counted and charged what it costs on the target.
+    struct BusCounters {
+        uint64_t gpioWrites;
+        uint64_t gpioReads;
+        uint64_t sysTickReads;
+        uint64_t cycles;        // modeled Cortex-M0 cycles of the above
+    };
+
+    // Cortex-M0 cycles at zero wait states: GPIO_SetBit / ClearBit is an
+    // LDR, ORR / BIC, STR on a constant mask, GPIO_Write an ORR and STR of a
+    // word held in registers, GPIO_CheckBit an LDR, shift and AND, and one
+    // SysTick poll is one pass of the delay loop in sys.cpp (LDR, compare,
+    // delta, accumulate, branch). GPIO_Wait() costs the cycles it pads.
+    constexpr uint32_t GPIO_WRITE_CYCLES = 6;
+    constexpr uint32_t GPIO_STORE_CYCLES = 3;
+    constexpr uint32_t GPIO_READ_CYCLES = 4;
+    constexpr uint32_t SYSTICK_POLL_CYCLES = 12;
+    constexpr uint32_t CPU_CLOCK_MHZ = 48;
+
+    const BusCounters& busCounters(void);
+
+    // Virtual time: SysTick and nowNs() follow the modeled cycle count, so
+    // busy-wait delays cost exactly the cycles they poll for and return at
+    // once on the host. Only for single-threaded front ends.
+    void setVirtualTime(bool enabled);
+
+    // Pin read trace. RECORD stores every value gpioRead() returns, REPLAY
+    // hands them back with the models bypassed: the firmware takes the same
+    // path without the model cost, so its own host time can be measured.
+    enum class TraceMode : uint8_t {
+        OFF,
+        RECORD,
+        REPLAY
+    };
+
+    void setReadTrace(TraceMode mode, uint32_t* buffer, size_t capacity);
+    size_t getReadTracePosition(void);
+
+    BK4819Model& bk4819(void);
+    EEPROMModel& eeprom(void);
+    ST7565Model& display(void);
+
+    // UART1 register block with a hooked transmit data register
+    struct UartTxRegister {
+        void operator=(uint32_t value) volatile { uartTransmit((uint8_t)value); }
+    };
+
+    struct UartPort {
+        uint32_t CTRL;
+        uint32_t BAUD;
+        UartTxRegister TDR;
+        uint32_t RDR;
+        uint32_t IE;
+        uint32_t IF;
+        uint32_t FIFO;
+        uint32_t FC;
+        uint32_t RXTO;
+    };
+
+    extern volatile UartPort uart1;
+
+    // SysTick with a VAL register counting down at 48 MHz in host time. Every
+    // busy-wait delay polls it, so reading it also settles the keypad inputs.
+    struct SysTickValue {
+        operator uint32_t() const volatile;
+    };
+
+    struct SysTickPort {
+        uint32_t CTRL;
+        uint32_t LOAD;
+        SysTickValue VAL;
+        uint32_t CALIB;
+    };
+
+    extern volatile SysTickPort sysTick;
+
+    // CRC unit data registers, the result resets the unit for the next run
+    struct CrcDataIn {
+        void operator=(uint32_t value) volatile;
+    };
+
+    struct CrcDataOut {
+        operator uint32_t() const volatile;
+    };
+
+    extern volatile CrcDataIn crcDataIn;
+    extern volatile CrcDataOut crcDataOut;
+
+} // namespace HostSim
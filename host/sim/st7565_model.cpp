@@ -0,0 +1,78 @@
+#include "st7565_model.h"
+
+#include <cstdio>
+
+namespace HostSim {
+
+    void ST7565Model::command(uint8_t byte) {
+        commandBytes++;
+
+        if (argumentsPending) {
+            // Second byte of contrast (0x81) / booster (0xF8)
+            argumentsPending--;
+            return;
+        }
+
+        if ((byte & 0xF0) == 0xB0) {
+            page = (uint8_t)(byte & 0x0F);
+        }
+        else if ((byte & 0xF0) == 0x10) {
+            column = (uint8_t)((column & 0x0F) | ((byte & 0x0F) << 4));
+        }
+        else if ((byte & 0xF0) == 0x00) {
+            column = (uint8_t)((column & 0xF0) | (byte & 0x0F));
+        }
+        else if (byte == 0x81 || byte == 0xF8) {
+            argumentsPending = 1;
+        }
+    }
+
+    void ST7565Model::data(uint8_t byte) {
+        dataBytes++;
+
+        uint8_t x = (uint8_t)(column - columnOffset);
+        if (page < PAGES && x < WIDTH) {
+            pthread_mutex_lock(&lock);
+            if (ram[page][x] != byte) {
+                ram[page][x] = byte;
+                dirty = true;
+            }
+            pthread_mutex_unlock(&lock);
+        }
+        column++;
+    }
+
+    bool ST7565Model::dump(const char* path) {
+        uint8_t image[PAGES * 8][WIDTH / 8] = {};
+
+        pthread_mutex_lock(&lock);
+        if (!dirty) {
+            pthread_mutex_unlock(&lock);
+            return false;
+        }
+        for (uint8_t y = 0; y < PAGES * 8; y++) {
+            for (uint8_t x = 0; x < WIDTH; x++) {
+                if ((ram[y / 8][x] >> (y % 8)) & 1U) {
+                    image[y][x / 8] = (uint8_t)(image[y][x / 8] | (0x80U >> (x % 8)));
+                }
+            }
+        }
+        dirty = false;
+        pthread_mutex_unlock(&lock);
+
+        // Write a temporary file and rename it, viewers never see a torn frame
+        char tmpPath[256];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+        FILE* f = fopen(tmpPath, "wb");
+        if (!f) {
+            return false;
+        }
+        fprintf(f, "P4\n%u %u\n", WIDTH, PAGES * 8);
+        fwrite(image, sizeof(image), 1, f);
+        fclose(f);
+
+        return rename(tmpPath, path) == 0;
+    }
+
+} // namespace HostSim
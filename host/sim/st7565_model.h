@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <pthread.h>
+
+namespace HostSim {
+
+    // ST7565 controller model fed by the host u8g2 byte callback. Keeps the
+    // 128x64 display RAM and writes it out as a binary PBM when it changed.
+    class ST7565Model {
+    public:
+        static constexpr uint8_t WIDTH = 128;
+        static constexpr uint8_t PAGES = 8;
+
+        // Column the u8g2 driver adds to every column address
+        void setColumnOffset(uint8_t offset) { columnOffset = offset; }
+
+        void command(uint8_t byte);
+        void data(uint8_t byte);
+
+        // Writes the screen if anything was drawn since the last dump
+        bool dump(const char* path);
+
+        uint32_t getDataBytes(void) const { return dataBytes; }
+        uint32_t getCommandBytes(void) const { return commandBytes; }
+
+    private:
+        uint8_t ram[PAGES][WIDTH] = {};
+        uint8_t page = 0;
+        uint8_t column = 0;
+        uint8_t columnOffset = 0;
+        uint8_t argumentsPending = 0;
+        bool dirty = false;
+
+        uint32_t dataBytes = 0;
+        uint32_t commandBytes = 0;
+
+        pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    };
+
+} // namespace HostSim
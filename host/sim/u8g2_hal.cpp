@@ -0,0 +1,56 @@
+// Host build replacement for src/driver/u8g2_hal.cpp: the SPI0 byte stream
+// and the A0 (data/command) line go to the simulated ST7565.
+
+#include "u8g2_hal.h"
+
+#include "sys.h"
+#include "host_sim.h"
+#include "st7565_model.h"
+
+static bool dataMode = false;
+
+uint8_t u8x8_gpio_and_delay_cb(__attribute__((unused)) u8x8_t* u8g2, uint8_t msg, uint8_t arg_int, __attribute__((unused)) void* arg_ptr) {
+    switch (msg)
+    {
+    case U8X8_MSG_DELAY_MILLI:			// delay arg_int * 1 milli second
+        delayMs(arg_int);
+        break;
+    case U8X8_MSG_GPIO_DC:				// DC (data/cmd, A0, register select) pin: Output level in arg_int
+        dataMode = arg_int != 0;
+        break;
+    default:
+        break;
+    }
+    return 1;
+}
+
+uint8_t u8x8_hw_spi_cb(u8x8_t* u8g2, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    HostSim::ST7565Model& display = HostSim::display();
+    uint8_t* data;
+    switch (msg) {
+    case U8X8_MSG_BYTE_SEND: // write data to display
+        data = (uint8_t*)arg_ptr;
+        while (arg_int > 0) {
+            if (dataMode) {
+                display.data(*data);
+            }
+            else {
+                display.command(*data);
+            }
+            data++;
+            arg_int--;
+        }
+        break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+        display.setColumnOffset(u8g2->x_offset);
+        break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+        break;
+    case U8X8_MSG_BYTE_SET_DC:
+        u8x8_gpio_SetDC(u8g2, arg_int);
+        break;
+    default:
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "system.h"
+
+// Host tests for firmware behaviour that is easy to break and hard to see on
+// the radio.
+//
+// Cases run the firmware objects against the simulated board in virtual
+// time, like the benchmarks (see host/bench/bench.h). The system task is
+// built but never started and the EEPROM image is kept in memory, shared
+// by every case in file order.
+
+namespace Test {
+
+    struct Case {
+        const char* name;
+        void (*run)(System::SystemTask& systask);
+        Case* next;
+    };
+
+    // Cases register themselves from static constructors, in file order
+    struct Registrar {
+        Registrar(Case& testCase);
+    };
+
+    // Records a failed check against the running case
+    void fail(const char* file, int line, const char* expression);
+
+} // namespace Test
+
+#define TEST_CASE(id, name) \
+    static void id(System::SystemTask& systask); \
+    static Test::Case id##Case = { name, id, nullptr }; \
+    static Test::Registrar id##Registrar(id##Case); \
+    static void id(System::SystemTask& systask)
+
+#define TEST_CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            Test::fail(__FILE__, __LINE__, #expression); \
+        } \
+    } while (0)
@@ -0,0 +1,49 @@
+#include "test.h"
+
+namespace {
+
+    constexpr uint16_t CHANNEL = 1;
+    constexpr uint16_t CHANNEL_NAME_ADDRESS = 0x0050 + offsetof(Settings::PackedVFOData, name);
+
+    // The check the menus made before the occupancy map: a channel is used
+    // when the name readChannel() returns is not empty
+    bool nameShowsInUse(Settings& settings, uint16_t channel) {
+        Settings::VFO data;
+        if (!settings.readChannel(channel, data)) {
+            return false;
+        }
+        return data.name[0] != '\0' && data.name[0] != ' ';
+    }
+
+} // namespace
+
+// Every first name byte, written raw by the CPS and then scanned at boot,
+// gives the occupancy the channel name shows
+TEST_CASE(channelMapNames, "settings.channelMapNames") {
+    Settings& settings = systask.getSettings();
+
+    uint8_t saved = 0;
+    settings.getEEPROM().readBuffer(CHANNEL_NAME_ADDRESS, &saved, sizeof(saved));
+
+    for (uint16_t value = 0; value <= 0xFF; value++) {
+        uint8_t first = static_cast<uint8_t>(value);
+        TEST_CHECK(settings.writeImage(CHANNEL_NAME_ADDRESS, &first, sizeof(first)));
+        settings.getEEPROM().flush();
+
+        bool expected = nameShowsInUse(settings, CHANNEL);
+        TEST_CHECK(settings.isChannelInUse(CHANNEL) == expected);
+
+        settings.loadChannelMap();
+        TEST_CHECK(settings.isChannelInUse(CHANNEL) == expected);
+    }
+
+    // Erased EEPROM is an empty channel either way
+    uint8_t erased = 0xFF;
+    settings.writeImage(CHANNEL_NAME_ADDRESS, &erased, sizeof(erased));
+    TEST_CHECK(!settings.isChannelInUse(CHANNEL));
+    TEST_CHECK(!nameShowsInUse(settings, CHANNEL));
+
+    settings.writeImage(CHANNEL_NAME_ADDRESS, &saved, sizeof(saved));
+    settings.getEEPROM().flush();
+    settings.loadChannelMap();
+}
@@ -0,0 +1,39 @@
+#include "host_sim.h"
+#include "eeprom_model.h"
+
+#include "test.h"
+
+namespace {
+
+    constexpr uint16_t SCRATCH = 0x1D20;     // unused and page aligned
+    constexpr uint32_t WRITE_CYCLE_US = 3000;
+
+} // namespace
+
+// The write cycle in the stats is the time the part was busy, not the
+// number of polls it took
+TEST_CASE(eepromWriteCycleTime, "eeprom.writeCycleTime") {
+    EEPROM& eeprom = systask.getSettings().getEEPROM();
+
+    uint8_t saved[EEPROM::PAGE_SIZE];
+    eeprom.readBuffer(SCRATCH, saved, sizeof(saved));
+
+    uint8_t page[EEPROM::PAGE_SIZE];
+    for (uint8_t i = 0; i < EEPROM::PAGE_SIZE; i++) {
+        page[i] = static_cast<uint8_t>(saved[i] ^ 0x5A);
+    }
+
+    HostSim::eeprom().setWriteCycleTime(WRITE_CYCLE_US);
+    uint32_t pages = eeprom.getWriteStats().pages;
+    TEST_CHECK(eeprom.writeBuffer(SCRATCH, page, sizeof(page)));
+    TEST_CHECK(eeprom.flush());
+
+    const EEPROM::WriteStats& stats = eeprom.getWriteStats();
+    TEST_CHECK(stats.pages == pages + 1);
+    TEST_CHECK(stats.lastUs >= WRITE_CYCLE_US);
+    TEST_CHECK(stats.lastUs < WRITE_CYCLE_US + 200);
+
+    HostSim::eeprom().setWriteCycleTime(0);
+    eeprom.writeBuffer(SCRATCH, saved, sizeof(saved));
+    eeprom.flush();
+}
@@ -0,0 +1,110 @@
+// Test runner: builds the system task on the simulated board, runs every
+// case (or those whose name starts with an argument) and prints one line per
+// case. The exit status is the number of failed cases.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "host_sim.h"
+
+#include "test.h"
+
+// No UART, keypad or screen threads: the runner owns the firmware
+bool HostSim::headless = true;
+
+// Hooks src/main.cpp provides to FreeRTOS and printf, the scheduler never
+// starts here
+extern "C" {
+
+    void _putchar(__attribute__((unused)) char c) {}
+
+    void vApplicationStackOverflowHook(__attribute__((unused)) TaskHandle_t pxTask, __attribute__((unused)) char* pcTaskName) {
+        abort();
+    }
+
+    void vApplicationGetIdleTaskMemory(StaticTask_t** ppxIdleTaskTCBBuffer,
+        StackType_t** ppxIdleTaskStackBuffer,
+        uint32_t* pulIdleTaskStackSize) {
+        *ppxIdleTaskTCBBuffer = nullptr;
+        *ppxIdleTaskStackBuffer = nullptr;
+        *pulIdleTaskStackSize = 0;
+    }
+
+    void vApplicationGetTimerTaskMemory(StaticTask_t** ppxTimerTaskTCBBuffer,
+        StackType_t** ppxTimerTaskStackBuffer,
+        uint32_t* pulTimerTaskStackSize) {
+        *ppxTimerTaskTCBBuffer = nullptr;
+        *ppxTimerTaskStackBuffer = nullptr;
+        *pulTimerTaskStackSize = 0;
+    }
+
+}
+
+namespace Test {
+
+    namespace {
+
+        Case* firstCase = nullptr;
+        Case* lastCase = nullptr;
+
+        uint32_t failedChecks = 0;
+
+        bool selected(const char* name, int argc, char** argv) {
+            if (argc < 2) {
+                return true;
+            }
+            for (int i = 1; i < argc; i++) {
+                if (strncmp(name, argv[i], strlen(argv[i])) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    } // namespace
+
+    Registrar::Registrar(Case& testCase) {
+        if (lastCase) {
+            lastCase->next = &testCase;
+        }
+        else {
+            firstCase = &testCase;
+        }
+        lastCase = &testCase;
+    }
+
+    void fail(const char* file, int line, const char* expression) {
+        fprintf(stdout, "  %s:%d: %s\n", file, line, expression);
+        failedChecks++;
+    }
+
+} // namespace Test
+
+int main(int argc, char** argv) {
+    HostSim::setVirtualTime(true);
+
+    configureSysTick();
+    configureSysCon();
+    boardGPIOInit();
+    boardPORTCONInit();
+    boardADCInit();
+    CRCInit();
+
+    static System::SystemTask systemTask;
+
+    int failedCases = 0;
+    for (Test::Case* c = Test::firstCase; c; c = c->next) {
+        if (!Test::selected(c->name, argc, argv)) {
+            continue;
+        }
+        uint32_t before = Test::failedChecks;
+        c->run(systemTask);
+        bool passed = Test::failedChecks == before;
+        fprintf(stdout, "%s\t%s\n", c->name, passed ? "ok" : "FAILED");
+        failedCases += passed ? 0 : 1;
+    }
+    fflush(stdout);
+
+    return failedCases;
+}
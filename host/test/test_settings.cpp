@@ -0,0 +1,259 @@
+#include "host_sim.h"
+#include "eeprom_model.h"
+
+#include "test.h"
+
+namespace {
+
+    // CHIRP's UV-K5 driver moves the image in 0x80 byte blocks, in address
+    // order, and stops short of the calibration area
+    constexpr uint16_t CPS_BLOCK = 0x80;
+    constexpr uint16_t CPS_IMAGE_SIZE = 0x1E00;
+
+    uint8_t image[CPS_IMAGE_SIZE];
+
+    // Journal layout: one-page entries from the first page boundary of the
+    // reserved 0x1D10-0x1DFF range
+    constexpr uint16_t JOURNAL_START = 0x1D10;
+    constexpr uint16_t JOURNAL_END = 0x1E00;
+    constexpr uint16_t JOURNAL_SLOT_0 = 0x1D20;
+
+    uint16_t journalSlot(uint8_t slot) {
+        return (uint16_t)(JOURNAL_SLOT_0 + slot * EEPROM::PAGE_SIZE);
+    }
+
+    void fillJournal(Settings& settings, uint8_t value) {
+        uint8_t bytes[JOURNAL_END - JOURNAL_START];
+        memset(bytes, value, sizeof(bytes));
+        settings.getEEPROM().writeBuffer(JOURNAL_START, bytes, sizeof(bytes));
+        settings.getEEPROM().flush();
+    }
+
+    // A radio whose record at 0x0000 holds the defaults with the given
+    // contrast and journalBase, and an erased journal. The next save goes
+    // to slot 0.
+    void resetJournal(Settings& settings, uint8_t lcdContrast, uint16_t journalBase) {
+        fillJournal(settings, 0xFF);
+        settings.setRadioSettingsDefault();
+        settings.radioSettings.lcdContrast = lcdContrast & 0x0F;
+        settings.radioSettings.journalBase = journalBase;
+        settings.getEEPROM().writeBuffer(0x0000, &settings.radioSettings, sizeof(Settings::SETTINGS));
+        settings.getEEPROM().flush();
+        settings.getRadioSettings();
+    }
+
+    void saveContrast(Settings& settings, uint8_t lcdContrast) {
+        settings.radioSettings.lcdContrast = lcdContrast & 0x0F;
+        settings.saveRadioSettings();
+        settings.getEEPROM().flush();
+    }
+
+    void corrupt(Settings& settings, uint16_t address) {
+        uint8_t value = 0;
+        settings.getEEPROM().readBuffer(address, &value, sizeof(value));
+        value = (uint8_t)~value;
+        settings.getEEPROM().writeBuffer(address, &value, sizeof(value));
+        settings.getEEPROM().flush();
+    }
+
+    uint8_t bootContrast(System::SystemTask& systask) {
+        Settings rebooted(systask);
+        rebooted.getRadioSettings();
+        return rebooted.radioSettings.lcdContrast;
+    }
+
+    void cpsDownload(Settings& settings) {
+        for (uint16_t address = 0; address < CPS_IMAGE_SIZE; address = (uint16_t)(address + CPS_BLOCK)) {
+            settings.getEEPROM().readBuffer(address, &image[address], CPS_BLOCK);
+            settings.overlayRadioSettings(address, &image[address], CPS_BLOCK);
+        }
+    }
+
+    void cpsUpload(Settings& settings) {
+        for (uint16_t address = 0; address < CPS_IMAGE_SIZE; address = (uint16_t)(address + CPS_BLOCK)) {
+            settings.writeImage(address, &image[address], CPS_BLOCK);
+        }
+        settings.getEEPROM().flush();
+    }
+
+} // namespace
+
+// The upload writes the settings record at 0x0000 first and the image's
+// older copy of the journal afterwards: the uploaded settings must still be
+// the ones loaded at the next boot
+TEST_CASE(chirpUploadOrder, "settings.chirpUploadOrder") {
+    Settings& settings = systask.getSettings();
+
+    // A radio with a few saves in its journal
+    settings.setRadioSettingsDefault();
+    settings.saveRadioSettings();
+    settings.radioSettings.lcdContrast = 5;
+    settings.saveRadioSettings();
+    settings.radioSettings.micDB = Settings::MicDB::MIC_DB_3;
+    settings.saveRadioSettings();
+
+    cpsDownload(settings);
+
+    Settings::SETTINGS uploaded;
+    memcpy(&uploaded, image, sizeof(uploaded));
+    TEST_CHECK(uploaded.lcdContrast == 5);
+    uploaded.lcdContrast = 7;
+    uploaded.beep = Settings::ONOFF::OFF;
+    memcpy(image, &uploaded, sizeof(uploaded));
+
+    // Last bytes of channel 230, in the block that also holds the journal
+    image[0x1D0F] = 0x5A;
+
+    cpsUpload(settings);
+    TEST_CHECK(settings.radioSettings.lcdContrast == 7);
+
+    Settings rebooted(systask);
+    rebooted.getRadioSettings();
+    TEST_CHECK(rebooted.radioSettings.lcdContrast == 7);
+    TEST_CHECK(rebooted.radioSettings.beep == Settings::ONOFF::OFF);
+    TEST_CHECK(rebooted.radioSettings.micDB == Settings::MicDB::MIC_DB_3);
+
+    uint8_t tail = 0;
+    rebooted.getEEPROM().readBuffer(0x1D0F, &tail, sizeof(tail));
+    TEST_CHECK(tail == 0x5A);
+
+    // A second round trip starts from what the radio now reports
+    cpsDownload(rebooted);
+    memcpy(&uploaded, image, sizeof(uploaded));
+    TEST_CHECK(uploaded.lcdContrast == 7);
+}
+
+// A save takes one journal page, and a record the journal has never seen
+// still loads
+TEST_CASE(journalEmpty, "settings.journalEmpty") {
+    Settings& settings = systask.getSettings();
+
+    resetJournal(settings, 9, 0x00FF);
+    TEST_CHECK(bootContrast(systask) == 9);
+
+    // Zeroed instead of erased
+    fillJournal(settings, 0x00);
+    TEST_CHECK(bootContrast(systask) == 9);
+
+    resetJournal(settings, 9, 0x00FF);
+    uint32_t pages = HostSim::eeprom().getPageWriteCount();
+    saveContrast(settings, 3);
+    TEST_CHECK(HostSim::eeprom().getPageWriteCount() == pages + 1);
+    TEST_CHECK(bootContrast(systask) == 3);
+
+    // The record itself was left alone
+    Settings::SETTINGS record;
+    settings.getEEPROM().readBuffer(0x0000, &record, sizeof(record));
+    TEST_CHECK(record.lcdContrast == 9);
+}
+
+// Power lost during a save: the entry before it loads
+TEST_CASE(journalBadCRC, "settings.journalBadCRC") {
+    Settings& settings = systask.getSettings();
+
+    resetJournal(settings, 9, 0x00FF);
+    saveContrast(settings, 5);
+    saveContrast(settings, 6);
+    TEST_CHECK(bootContrast(systask) == 6);
+
+    corrupt(settings, (uint16_t)(journalSlot(1) + 12));
+    TEST_CHECK(bootContrast(systask) == 5);
+
+    corrupt(settings, journalSlot(0));
+    TEST_CHECK(bootContrast(systask) == 9);
+
+    // Saves go on from there
+    Settings rebooted(systask);
+    rebooted.getRadioSettings();
+    saveContrast(rebooted, 7);
+    TEST_CHECK(bootContrast(systask) == 7);
+}
+
+// Sequence numbers wrap: 0x0000 is newer than 0xFFFF
+TEST_CASE(journalSequenceWrap, "settings.journalSequenceWrap") {
+    Settings& settings = systask.getSettings();
+
+    // Saves 1 to 5 take the sequence numbers 0xFFFE to 0x0002, slots 0 to 4
+    resetJournal(settings, 9, 0xFFFD);
+    for (uint8_t contrast = 1; contrast <= 5; contrast++) {
+        saveContrast(settings, contrast);
+    }
+    TEST_CHECK(bootContrast(systask) == 5);
+
+    corrupt(settings, journalSlot(4));
+    corrupt(settings, journalSlot(3));
+    TEST_CHECK(bootContrast(systask) == 3);
+
+    corrupt(settings, journalSlot(2));
+    TEST_CHECK(bootContrast(systask) == 2);
+
+    // Older than the record: folded in, the record wins
+    resetJournal(settings, 9, 0xFFFD);
+    saveContrast(settings, 4);
+    Settings::SETTINGS record;
+    settings.getEEPROM().readBuffer(0x0000, &record, sizeof(record));
+    record.journalBase = 0xFFFE;
+    settings.getEEPROM().writeBuffer(0x0000, &record, sizeof(record));
+    settings.getEEPROM().flush();
+    TEST_CHECK(bootContrast(systask) == 9);
+}
+
+// Changes that outgrow an entry are written to the record instead
+TEST_CASE(journalFold, "settings.journalFold") {
+    Settings& settings = systask.getSettings();
+
+    resetJournal(settings, 9, 0x00FF);
+    saveContrast(settings, 4);
+    settings.radioSettings.lcdContrast = 5;
+    for (uint8_t i = 0; i < sizeof(settings.radioSettings.vfo[0].name) - 1; i++) {
+        settings.radioSettings.vfo[0].name[i] = (char)('A' + i);
+        settings.radioSettings.vfo[1].name[i] = (char)('a' + i);
+    }
+    settings.saveRadioSettings();
+    settings.getEEPROM().flush();
+
+    Settings::SETTINGS record;
+    settings.getEEPROM().readBuffer(0x0000, &record, sizeof(record));
+    TEST_CHECK(record.lcdContrast == 5);
+    TEST_CHECK(record.vfo[1].name[8] == 'i');
+
+    // The entry with contrast 4 was folded in and no longer applies
+    Settings rebooted(systask);
+    rebooted.getRadioSettings();
+    TEST_CHECK(rebooted.radioSettings.lcdContrast == 5);
+    TEST_CHECK(memcmp(rebooted.radioSettings.vfo, settings.radioSettings.vfo, sizeof(record.vfo)) == 0);
+
+    saveContrast(settings, 2);
+    TEST_CHECK(bootContrast(systask) == 2);
+}
+
+// CPS writes leave 0x1D10-0x1DFF to the radio and still write around it
+TEST_CASE(writeImageJournal, "settings.writeImageJournal") {
+    Settings& settings = systask.getSettings();
+
+    resetJournal(settings, 9, 0x00FF);
+    saveContrast(settings, 6);
+
+    uint8_t journal[JOURNAL_END - JOURNAL_START];
+    settings.getEEPROM().readBuffer(JOURNAL_START, journal, sizeof(journal));
+
+    // Channel 230's tail, the journal and the first calibration bytes
+    uint8_t block[0x120];
+    memset(block, 0xA5, sizeof(block));
+    TEST_CHECK(!settings.writeImage(0x1D00, block, sizeof(block)));
+
+    uint8_t after[JOURNAL_END - JOURNAL_START];
+    settings.getEEPROM().readBuffer(JOURNAL_START, after, sizeof(after));
+    TEST_CHECK(memcmp(journal, after, sizeof(after)) == 0);
+
+    uint8_t tail[0x10];
+    settings.getEEPROM().readBuffer(0x1D00, tail, sizeof(tail));
+    TEST_CHECK(tail[0] == 0xA5 && tail[sizeof(tail) - 1] == 0xA5);
+
+    // Inside the journal only: nothing to write, nothing failed
+    TEST_CHECK(settings.writeImage(0x1D80, block, 0x80));
+    settings.getEEPROM().readBuffer(JOURNAL_START, after, sizeof(after));
+    TEST_CHECK(memcmp(journal, after, sizeof(after)) == 0);
+
+    TEST_CHECK(bootContrast(systask) == 6);
+}
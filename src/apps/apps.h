@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FreeRTOS.h"
+#include "task.h"
 #include "ui.h"
 #include "keyboard.h"
 
@@ -30,14 +32,56 @@ namespace Applications
     public:
         explicit Application(System::SystemTask& systask, UI &ui) : systask{ systask }, ui{ui} {};
 
+        // Screen regions, one bit per 8 pixel row of the display (ST7565 page)
+        static constexpr uint8_t REGION_ALL = 0xFF;
+
+        static constexpr uint8_t region(uint8_t y, uint8_t height) {
+            return (uint8_t)((0xFFU << (y >> 3)) & (0xFFU >> (7 - ((y + height - 1) >> 3))));
+        }
+
         virtual void init(void) = 0;
+        // App logic, every 100 ms while there is activity and once a second
+        // when idle (see SystemTask::requestFrameBoost). It must not draw: it
+        // calls invalidate() when something on the screen changed
         virtual void update(void) {};
+        // Draws the whole screen. It can run several times per frame, once
+        // per display buffer pass, so it must not change the app state
+        virtual void render(void) = 0;
         virtual void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) = 0;
         virtual void timeout(void) {};
 
+        // Marks part of the screen as stale, the frame scheduler redraws it
+        void invalidate(uint8_t regions = REGION_ALL) {
+            taskENTER_CRITICAL();
+            invalidRegions |= regions;
+            taskEXIT_CRITICAL();
+        }
+
+        // Draws and sends the regions given, the frame scheduler passes the
+        // invalidated ones
+        void drawScreen(uint8_t regions = REGION_ALL) {
+            if (ui.beginFrame(regions)) {
+                do {
+                    render();
+                } while (ui.nextPage());
+            }
+        }
+
+        // Returns the stale regions and clears them
+        uint8_t takeInvalidRegions(void) {
+            taskENTER_CRITICAL();
+            uint8_t regions = invalidRegions;
+            invalidRegions = 0;
+            taskEXIT_CRITICAL();
+            return regions;
+        }
+
     protected:
         System::SystemTask& systask;
         UI& ui;
+
+    private:
+        uint8_t invalidRegions = REGION_ALL;
     };
 
 } // namespace Applications
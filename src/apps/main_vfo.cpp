@@ -3,11 +3,12 @@
 #include "main_vfo.h"
 #include "system.h"
 #include "ui.h"
+#include "code_labels.h"
 #include "u8g2.h"
 
 using namespace Applications;
 
-void MainVFO::drawScreen(void) {
+void MainVFO::render(void) {
 
     Settings::VFOAB activeVFO1 = radio.getCurrentVFO();
     Settings::VFOAB activeVFO2 = activeVFO1 == Settings::VFOAB::VFOA ? Settings::VFOAB::VFOB : Settings::VFOAB::VFOA;
@@ -21,12 +22,12 @@ void MainVFO::drawScreen(void) {
 
     bool activeMemoryMode = settings.radioSettings.showVFO[(uint8_t)activeVFO1] == Settings::ONOFF::OFF;
 
-    ui.clearDisplay();
-
+    if (!staticLayer.draw(ui.lcd()->getU8g2())) {
+        renderStatic();
+        staticLayer.capture(ui.lcd()->getU8g2());
+    }
     ui.lcd()->setColorIndex(BLACK);
 
-    ui.lcd()->drawBox(0, 0, 128, 7);
-
     ui.setFont(Font::FONT_8B_TR);
     const char* displayNameVFO1 = vfo1.name;
     if (!activeMemoryMode) {
@@ -38,34 +39,34 @@ void MainVFO::drawScreen(void) {
     ui.drawString(TextAlign::LEFT, 1, 0, 6, false, false, false, displayNameVFO1);
 
     ui.setFont(Font::FONT_5_TR);
-    const char* powerA = ui.getStrValue(Settings::powerStr, (uint8_t)vfo1.power);
-    const char* bandwidthA = ui.getStrValue(Settings::bandwidthStr, (uint8_t)vfo1.bw);
-    const char* modulationA = ui.getStrValue(Settings::modulationStr, (uint8_t)vfo1.modulation);
+    const char* powerA = Settings::powerStr.get((uint8_t)vfo1.power);
+    const char* bandwidthA = Settings::bandwidthStr.get((uint8_t)vfo1.bw);
+    const char* modulationA = Settings::modulationStr.get((uint8_t)vfo1.modulation);
     const char* rxCode;
     const char* txCode;
     uint8_t codeXend = 127;
 
     if (vfo1.rx.codeType == Settings::CodeType::CT) {
-        rxCode = ui.getStrValue(ui.generateCTDCList(Settings::CTCSSOptions, 50), (uint8_t)vfo1.rx.code);
-        ui.drawStringf(TextAlign::RIGHT, 0, codeXend, 26, true, radio.isRXToneDetected(), false, "%s %.*s%s", ui.RXStr, ui.stringLengthNL(rxCode), rxCode, ui.HZStr);
+        rxCode = CodeLabels::CTCSS.get((uint8_t)vfo1.rx.code);
+        ui.drawText(TextAlign::RIGHT, 0, codeXend, 26, true, radio.isRXToneDetected(), false, ui.RXStr, ' ', rxCode, ui.HZStr);
         codeXend -= 48;
     }
     else if (vfo1.rx.codeType == Settings::CodeType::DCS || vfo1.rx.codeType == Settings::CodeType::NDCS) {
-        rxCode = ui.getStrValue(ui.generateCTDCList(Settings::DCSOptions, 104, false), (uint8_t)vfo1.rx.code);
-        ui.drawStringf(TextAlign::RIGHT, 0, codeXend, 26, true, radio.isRXToneDetected(), false, "%s %.*s%s", ui.RXStr, ui.stringLengthNL(rxCode), rxCode, vfo1.rx.codeType == Settings::CodeType::NDCS ? "N" : "I");
+        rxCode = CodeLabels::DCS.get((uint8_t)vfo1.rx.code);
+        ui.drawText(TextAlign::RIGHT, 0, codeXend, 26, true, radio.isRXToneDetected(), false, ui.RXStr, ' ', rxCode, vfo1.rx.codeType == Settings::CodeType::NDCS ? 'N' : 'I');
         codeXend -= 48;
     }
 
     if (vfo1.tx.codeType == Settings::CodeType::CT) {
-        txCode = ui.getStrValue(ui.generateCTDCList(Settings::CTCSSOptions, 50), (uint8_t)vfo1.tx.code);
-        ui.drawStringf(TextAlign::RIGHT, 0, codeXend, 26, true, txVFO1, false, "%s %.*s%s", ui.TXStr, ui.stringLengthNL(txCode), txCode, ui.HZStr);
+        txCode = CodeLabels::CTCSS.get((uint8_t)vfo1.tx.code);
+        ui.drawText(TextAlign::RIGHT, 0, codeXend, 26, true, txVFO1, false, ui.TXStr, ' ', txCode, ui.HZStr);
     }
     else if (vfo1.tx.codeType == Settings::CodeType::DCS || vfo1.tx.codeType == Settings::CodeType::NDCS) {
-        txCode = ui.getStrValue(ui.generateCTDCList(Settings::DCSOptions, 104, false), (uint8_t)vfo1.tx.code);
-        ui.drawStringf(TextAlign::RIGHT, 0, codeXend, 26, true, txVFO1, false, "%s %.*s%s", ui.TXStr, ui.stringLengthNL(txCode), txCode, vfo1.tx.codeType == Settings::CodeType::NDCS ? "N" : "I");
+        txCode = CodeLabels::DCS.get((uint8_t)vfo1.tx.code);
+        ui.drawText(TextAlign::RIGHT, 0, codeXend, 26, true, txVFO1, false, ui.TXStr, ' ', txCode, vfo1.tx.codeType == Settings::CodeType::NDCS ? 'N' : 'I');
     }
 
-    ui.drawStringf(TextAlign::RIGHT, 0, 127, 6, false, false, false, "%.*s %.*sK %.*s", ui.stringLengthNL(modulationA), modulationA, ui.stringLengthNL(bandwidthA), bandwidthA, ui.stringLengthNL(powerA), powerA);
+    ui.drawText(TextAlign::RIGHT, 0, 127, 6, false, false, false, modulationA, ' ', bandwidthA, "K ", powerA);
 
     ui.setFont(Font::FONT_8_TR);
     ui.lcd()->setColorIndex(BLACK);
@@ -74,12 +75,12 @@ void MainVFO::drawScreen(void) {
     const char* labelText = ui.VFOStr;
 
     if (activeMemoryMode && channelEntryActive && channelEntryValue > 0) {
-        snprintf(modeLabel, sizeof(modeLabel), "CH-%03u*", channelEntryValue);
+        Fmt::format(modeLabel, sizeof(modeLabel), "CH-", Fmt::zero<3>(channelEntryValue), '*');
         labelText = modeLabel;
     } else if (activeMemoryMode) {
         uint16_t mem = settings.radioSettings.memory[(uint8_t)activeVFO1];
         if (mem >= 1 && mem <= Settings::MAX_CHANNELS) {
-            snprintf(modeLabel, sizeof(modeLabel), "CH-%03u", mem);
+            Fmt::format(modeLabel, sizeof(modeLabel), "CH-", Fmt::zero<3>(mem));
             labelText = modeLabel;
         }
     }
@@ -89,9 +90,9 @@ void MainVFO::drawScreen(void) {
     //ui.lcd()->drawLine(5, 9, 5, 25);
 
     ui.setFont(Font::FONT_8B_TR);
-    bool showA = !(lastRXVFO == activeVFO1 && lastRXCounter > 0 && blinkState);
+    bool showA = !(lastRXVFO == activeVFO1 && lastRXActive && blinkState);
     if (showA)
-        ui.drawStringf(TextAlign::LEFT, 2, 0, 14, true, true, false, "%s", activeVFO1 == Settings::VFOAB::VFOA ? "A" : "B");
+        ui.drawString(TextAlign::LEFT, 2, 0, 14, true, true, false, activeVFO1 == Settings::VFOAB::VFOA ? "A" : "B");
 
     if (rxVFO1) {
         ui.drawString(TextAlign::LEFT, 12, 0, 14, true, true, false, ui.RXStr);
@@ -122,10 +123,7 @@ void MainVFO::drawScreen(void) {
     bool invertFreqVFO1 = txVFO1 || rxVFO1 || showFreqInput;
     ui.drawFrequencyBig(invertFreqVFO1, displayFreqVFO1, 111, 19);
 
-    uint8_t vfoBY = 28;
-
-    ui.lcd()->setColorIndex(BLACK);
-    ui.lcd()->drawBox(0, vfoBY, 128, 7);
+    uint8_t vfoBY = VFO_B_Y;
 
     bool activeMemoryModeVFO2 = settings.radioSettings.showVFO[(uint8_t)activeVFO2] == Settings::ONOFF::OFF;
 
@@ -137,20 +135,20 @@ void MainVFO::drawScreen(void) {
             displayNameVFO2 = bandName;
         }
     }
-    ui.drawStringf(TextAlign::LEFT, 1, 0, vfoBY + 6, false, false, false, "%S", displayNameVFO2);
+    ui.drawString(TextAlign::LEFT, 1, 0, vfoBY + 6, false, false, false, displayNameVFO2);
 
-    const char* powerB = ui.getStrValue(Settings::powerStr, (uint8_t)vfo2.power);
-    const char* bandwidthB = ui.getStrValue(Settings::bandwidthStr, (uint8_t)vfo2.bw);
-    const char* modulationB = ui.getStrValue(Settings::modulationStr, (uint8_t)vfo2.modulation);
+    const char* powerB = Settings::powerStr.get((uint8_t)vfo2.power);
+    const char* bandwidthB = Settings::bandwidthStr.get((uint8_t)vfo2.bw);
+    const char* modulationB = Settings::modulationStr.get((uint8_t)vfo2.modulation);
 
-    ui.drawStringf(TextAlign::RIGHT, 0, 127, vfoBY + 6, false, false, false, "%.*s %.*sK %.*s", ui.stringLengthNL(modulationB), modulationB, ui.stringLengthNL(bandwidthB), bandwidthB, ui.stringLengthNL(powerB), powerB);
+    ui.drawText(TextAlign::RIGHT, 0, 127, vfoBY + 6, false, false, false, modulationB, ' ', bandwidthB, "K ", powerB);
 
     ui.drawFrequencySmall(rxVFO2, vfo2.rx.frequency, 126, vfoBY + 17);
 
     ui.setFont(Font::FONT_8B_TR);
-    bool showB = !(lastRXVFO == activeVFO2 && lastRXCounter > 0 && blinkState);
+    bool showB = !(lastRXVFO == activeVFO2 && lastRXActive && blinkState);
     if (showB)
-        ui.drawStringf(TextAlign::LEFT, 2, 0, vfoBY + 15, true, false, true, "%s", activeVFO2 == Settings::VFOAB::VFOB ? "B" : "A");
+        ui.drawString(TextAlign::LEFT, 2, 0, vfoBY + 15, true, false, true, activeVFO2 == Settings::VFOAB::VFOB ? "B" : "A");
 
     if ((rxVFO2 && vfo2.rx.codeType != Settings::CodeType::NONE && radio.isRXToneDetected()) 
         || (rxVFO2 && vfo2.rx.codeType == Settings::CodeType::NONE)) {
@@ -162,7 +160,7 @@ void MainVFO::drawScreen(void) {
         if (activeMemoryModeVFO2) {
             uint16_t mem = settings.radioSettings.memory[(uint8_t)activeVFO2];
             if (mem >= 1 && mem <= Settings::MAX_CHANNELS) {
-                snprintf(modeLabel, sizeof(modeLabel), "CH-%03u", mem);
+                Fmt::format(modeLabel, sizeof(modeLabel), "CH-", Fmt::zero<3>(mem));
                 labelText = modeLabel;
             }
         }
@@ -171,7 +169,7 @@ void MainVFO::drawScreen(void) {
 
     ui.lcd()->setColorIndex(BLACK);
 
-    showRSSI(1, 52);
+    showRSSI(RSSI_X, RSSI_Y);
 
     //ui.draw_dotline(0, 47, BLACK);
 
@@ -185,7 +183,7 @@ void MainVFO::drawScreen(void) {
     }
 
     ui.setFont(Font::FONT_5_TR);
-    ui.drawStringf(TextAlign::RIGHT, 0, 128, 64, true, false, false, "%i%%", systask.getBattery().getBatteryPercentage());
+    ui.drawText(TextAlign::RIGHT, 0, 128, 64, true, false, false, Fmt::percent(systask.getBattery().getBatteryPercentage()));
 
     if (systask.wasFKeyPressed()) {
         ui.drawString(TextAlign::RIGHT, 0, 97, 56, true, true, false, "F");
@@ -213,8 +211,15 @@ void MainVFO::drawScreen(void) {
     if (popupSelected != NONE) {
         popupList.drawPopup(ui);
     }
+}
 
-    ui.updateDisplay();
+// What stays the same from frame to frame, drawn first and kept in
+// staticLayer
+void MainVFO::renderStatic(void) {
+    ui.lcd()->setColorIndex(BLACK);
+    ui.lcd()->drawBox(0, 0, 128, 7);
+    ui.lcd()->drawBox(0, VFO_B_Y, 128, 7);
+    ui.draw_smeter(RSSI_X, RSSI_Y + 1, BLACK);
 }
 
 void MainVFO::showRSSI(uint8_t posX, uint8_t posY) {
@@ -236,10 +241,10 @@ void MainVFO::showRSSI(uint8_t posX, uint8_t posY) {
     if (sValue > 0) {
         if (sValue == 10) {
             ui.drawString(TextAlign::LEFT, posX + 38, 0, posY + 5, true, false, false, "S9");
-            ui.drawStringf(TextAlign::LEFT, posX + 38, 0, posY + 12, true, false, false, "+%idB", plusDB);
+            ui.drawText(TextAlign::LEFT, posX + 38, 0, posY + 12, true, false, false, '+', Fmt::sdec(plusDB), "dB");
         }
         else {
-            ui.drawStringf(TextAlign::LEFT, posX + 38, 0, posY + 5, true, false, false, "S%i", sValue);
+            ui.drawText(TextAlign::LEFT, posX + 38, 0, posY + 5, true, false, false, 'S', Fmt::sdec(sValue));
         }
     }
 
@@ -247,13 +252,12 @@ void MainVFO::showRSSI(uint8_t posX, uint8_t posY) {
 }
 
 void MainVFO::init(void) {
+    staticLayer.invalidate();
+    shownState = getScreenState();
     prevRadioState = radio.getState();
     prevRXVFO = radio.getRXVFO();
-    lastRXCounter = 0;
-    blinkTimer = 0;
+    lastRXActive = false;
     blinkState = false;
-    memoryChannelCount = 0;
-    memoryChannelListValid = false;
 
     auto& settings = systask.getSettings();
     for (uint8_t index = 0; index < 2; ++index) {
@@ -268,12 +272,11 @@ void MainVFO::init(void) {
             }
         }
     }
-
-    // Preload the list of occupied memory channels so navigation is instant after power-on.
-    refreshMemoryChannelList();
 }
 
 void MainVFO::update(void) {
+    uint32_t now = getElapsedMilliseconds();
+
     // Track radio state transitions for RX activity
     Settings::RadioState curState = radio.getState();
     if (curState == Settings::RadioState::RX_ON) {
@@ -283,20 +286,48 @@ void MainVFO::update(void) {
         if (prevRadioState == Settings::RadioState::RX_ON) {
             // RX just finished, start blink period
             lastRXVFO = prevRXVFO;
-            lastRXCounter = LAST_RX_DURATION;
-        } else if (lastRXCounter > 0) {
-            lastRXCounter--;
+            lastRXTime = now;
+            lastRXActive = true;
+        } else if (lastRXActive && now - lastRXTime >= LAST_RX_DURATION_MS) {
+            lastRXActive = false;
         }
     }
     prevRadioState = curState;
 
     // Handle blink timing
-    if (++blinkTimer >= BLINK_INTERVAL) {
-        blinkTimer = 0;
-        blinkState = !blinkState;
+    blinkState = ((now - lastRXTime) / BLINK_INTERVAL_MS) & 1U;
+
+    // Redraw only what changed since the last frame
+    ScreenState state = getScreenState();
+    if (state.radioState != shownState.radioState || state.rxVFO != shownState.rxVFO ||
+        state.toneDetected != shownState.toneDetected || state.blinkHidden != shownState.blinkHidden) {
+        invalidate();
     }
+    else if (state.sValue != shownState.sValue || state.plusDB != shownState.plusDB ||
+        state.powerSave != shownState.powerSave || state.savePending != shownState.savePending) {
+        invalidate(STATUS_REGION);
+    }
+    shownState = state;
+}
 
-    drawScreen();
+MainVFO::ScreenState MainVFO::getScreenState(void) {
+    ScreenState state = {};
+    state.radioState = radio.getState();
+    state.toneDetected = radio.isRXToneDetected();
+    state.blinkHidden = lastRXActive && blinkState;
+    state.powerSave = radio.isPowerSaveMode();
+    state.savePending = systask.getSettings().isRadioSavePending();
+
+    // Dual watch moves the RX VFO on every hop, it only shows while receiving
+    if (state.radioState == Settings::RadioState::RX_ON) {
+        state.rxVFO = radio.getRXVFO();
+        int16_t rssi_dBm = radio.getRSSIdBm();
+        state.sValue = radio.convertRSSIToSLevel(rssi_dBm);
+        if (state.sValue == 10) {
+            state.plusDB = radio.convertRSSIToPlusDB(rssi_dBm);
+        }
+    }
+    return state;
 }
 
 void MainVFO::timeout(void) {
@@ -419,7 +450,7 @@ void MainVFO::action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) {
                 };
 
                 if (keyCode == Keyboard::KeyCode::KEY_UP) {
-                    if (!ensureMemoryChannelList()) {
+                    if (settings.getChannelsInUseCount() == 0) {
                         radio.playBeep(Settings::BEEPType::BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL);
                         return;
                     }
@@ -432,7 +463,7 @@ void MainVFO::action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) {
                     }
                 }
                 else if (keyCode == Keyboard::KeyCode::KEY_DOWN) {
-                    if (!ensureMemoryChannelList()) {
+                    if (settings.getChannelsInUseCount() == 0) {
                         radio.playBeep(Settings::BEEPType::BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL);
                         return;
                     }
@@ -512,7 +543,7 @@ void MainVFO::action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) {
                     channelEntryValue = 0;
                     showFreqInput = false;
                     freqInput = 0;
-                    if (!ensureMemoryChannelList()) {
+                    if (settings.getChannelsInUseCount() == 0) {
                         radio.playBeep(Settings::BEEPType::BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL);
                         return;
                     }
@@ -568,60 +599,29 @@ void MainVFO::action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) {
     }
 }
 
-void MainVFO::refreshMemoryChannelList() {
-    auto& settings = systask.getSettings();
-    memoryChannelCount = 0;
-    for (uint16_t ch = 1; ch <= Settings::MAX_CHANNELS; ++ch) {
-        if (settings.isChannelInUse(ch)) {
-            memoryChannelList[memoryChannelCount++] = ch;
-        }
-    }
-    memoryChannelListValid = true;
-}
-
-bool MainVFO::ensureMemoryChannelList() {
-    if (!memoryChannelListValid) {
-        refreshMemoryChannelList();
-    }
-    return memoryChannelCount > 0;
-}
-
 bool MainVFO::getNextMemoryChannel(uint16_t currentChannel, int direction, uint16_t& result) {
-    if (memoryChannelCount == 0) {
+    auto& settings = systask.getSettings();
+    if (settings.getChannelsInUseCount() == 0) {
         return false;
     }
 
-    int32_t index = -1;
-    for (uint16_t i = 0; i < memoryChannelCount; ++i) {
-        if (memoryChannelList[i] == currentChannel) {
-            index = static_cast<int32_t>(i);
-            break;
-        }
-    }
-
-    if (index == -1) {
-        index = (direction > 0) ? 0 : static_cast<int32_t>(memoryChannelCount) - 1;
+    if (!settings.isChannelInUse(currentChannel)) {
+        result = (direction > 0) ? settings.getFirstChannel() : settings.getLastChannel();
     } else if (direction > 0) {
-        index = (index + 1) % memoryChannelCount;
+        result = settings.getNextChannel(currentChannel);
     } else {
-        index = (index == 0) ? memoryChannelCount - 1 : index - 1;
+        result = settings.getPreviousChannel(currentChannel);
     }
-
-    result = memoryChannelList[index];
     return true;
 }
 
 uint16_t MainVFO::resolveActiveMemoryChannel(uint8_t vfoIndex) {
     auto& settings = systask.getSettings();
     uint16_t stored = settings.radioSettings.memory[vfoIndex];
-    if (stored >= 1) {
-        for (uint16_t i = 0; i < memoryChannelCount; ++i) {
-            if (memoryChannelList[i] == stored) {
-                return stored;
-            }
-        }
+    if (settings.isChannelInUse(stored)) {
+        return stored;
     }
-    return memoryChannelCount > 0 ? memoryChannelList[0] : 0;
+    return settings.getChannelsInUseCount() > 0 ? settings.getFirstChannel() : 0;
 }
 
 void MainVFO::applyActiveVFO(const Settings::VFO& vfo) {
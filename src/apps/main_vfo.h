@@ -4,6 +4,7 @@
 #include "ui.h"
 #include "radio.h"
 #include "settings.h"
+#include "static_layer.h"
 
 namespace Applications
 {
@@ -14,15 +15,13 @@ namespace Applications
             : Application(systask, ui), radio{ radio }, popupList(ui) {
         }
 
-        void drawScreen(void);
+        void render(void);
         void init(void);
         void update(void);
         void timeout(void);
         void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState);
 
     private:
-        void refreshMemoryChannelList();
-        bool ensureMemoryChannelList();
         bool getNextMemoryChannel(uint16_t currentChannel, int direction, uint16_t& result);
         uint16_t resolveActiveMemoryChannel(uint8_t vfoIndex);
         void applyActiveVFO(const Settings::VFO& vfo);
@@ -42,35 +41,59 @@ namespace Applications
         uint32_t freqInput = 0;
         PopupList popupSelected = NONE;
 
-        // Timings
-        static constexpr uint8_t BLINK_INTERVAL = 10;    // 1s with 100ms updates
-        static constexpr uint16_t LAST_RX_DURATION = 1200; // 2 minutes
+        // Timings, in ms: update() runs less often when the radio is idle
+        static constexpr uint16_t BLINK_INTERVAL_MS = 1000;
+        static constexpr uint32_t LAST_RX_DURATION_MS = 120000; // 2 minutes
 
         // Track which VFO had the last reception
         Settings::VFOAB lastRXVFO = Settings::VFOAB::NONE;
-        uint16_t lastRXCounter = 0;    // counter in 100ms units
+        uint32_t lastRXTime = 0;
+        bool lastRXActive = false;
 
         // Previous radio state for detecting RX termination
         Settings::RadioState prevRadioState = Settings::RadioState::IDLE;
         Settings::VFOAB prevRXVFO = Settings::VFOAB::NONE;
 
         // Blink handling
-        uint8_t blinkTimer = 0;
-
         bool blinkState = false;
 
+        // What the screen shows that changes without a key press, the frame
+        // is redrawn when it differs from the last update
+        struct ScreenState {
+            Settings::RadioState radioState;
+            Settings::VFOAB rxVFO;
+            uint8_t sValue;
+            int16_t plusDB;
+            bool toneDetected;
+            bool blinkHidden;
+            bool powerSave;
+            bool savePending;
+        };
+
+        ScreenState shownState = {};
+
+        // S-meter and the icons in the bottom row
+        static constexpr uint8_t STATUS_REGION = region(48, 16);
+
+        // Layout
+        static constexpr uint8_t VFO_B_Y = 28;
+        static constexpr uint8_t RSSI_X = 1;
+        static constexpr uint8_t RSSI_Y = 52;
+
+        // The two header bars and the S-meter scale: a span per bar page
+        // (one byte each) and two for the 35 scale columns
+        StaticLayer<6, 80> staticLayer;
+
         Settings::VFO vfoMemoryBackup[2]{};
         bool vfoMemoryBackupValid[2] = { false, false };
         bool channelEntryActive = false;
         uint16_t channelEntryValue = 0;
 
-        uint16_t memoryChannelList[Settings::MAX_CHANNELS] = {};
-        uint16_t memoryChannelCount = 0;
-        bool memoryChannelListValid = false;
-
         uint8_t convertRSSIToSLevel(int16_t rssi_dBm);
         int16_t convertRSSIToPlusDB(int16_t rssi_dBm);
         void showRSSI(uint8_t posX, uint8_t posY);
+        void renderStatic(void);
+        ScreenState getScreenState(void);
         void savePopupValue(void);
 
     };
@@ -8,9 +8,7 @@
 
 using namespace Applications;
 
-void Menu::drawScreen(void) {
-
-    ui.clearDisplay();
+void Menu::render(void) {
 
     ui.setBlackColor();
 
@@ -18,13 +16,11 @@ void Menu::drawScreen(void) {
     
     ui.setFont(Font::FONT_8B_TR);
     ui.drawString(TextAlign::LEFT, 2, 0, 6, false, false, false, "MENU");
-    ui.drawStringf(TextAlign::RIGHT, 0, 126, 6, false, false, false, "%02u / %02u", menulist.getListPos() + 1, menulist.getTotal());
+    ui.drawText(TextAlign::RIGHT, 0, 126, 6, false, false, false, Fmt::zero<2>(menulist.getListPos() + 1), " / ", Fmt::zero<2>(menulist.getTotal()));
 
     ui.setBlackColor();
 
     menulist.draw(15);
-
-    ui.updateDisplay();
 }
 
 
@@ -33,14 +29,11 @@ void Menu::init(void) {
     const char* first = firstVFOIsA ? "VFO A SETTINGS" : "VFO B SETTINGS";
     const char* second = firstVFOIsA ? "VFO B SETTINGS" : "VFO A SETTINGS";
 
-    snprintf(menuText, sizeof(menuText), "%s\n%s\nRADIO SETTINGS\nMESSENGER\nSCANNER\nABOUT", first, second);
+    Fmt::format(menuText, sizeof(menuText), first, '\n', second, "\nRADIO SETTINGS\nMESSENGER\nSCANNER\nABOUT");
     menulist.set(0, 6, 127, menuText);
     //drawScreen();
 }
 
-void Menu::update(void) {
-    drawScreen();
-}
 
 void Menu::timeout(void) {
     systask.pushMessage(System::SystemTask::SystemMSG::MSG_APP_LOAD, (uint32_t)Applications::MainVFO);
@@ -13,9 +13,8 @@ namespace Applications
             : Application(systask, ui), radio{ radio }, menulist(ui) {
         }
 
-        void drawScreen(void);
+        void render(void);
         void init(void);
-        void update(void);
         void timeout(void);
         void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState);
 
@@ -17,6 +17,8 @@ void Messenger::init(void) {
     lastKey = Keyboard::KeyCode::KEY_INVALID;
     lastKeyCycle = 0;
     lastKeyTime = 0;
+    popupLen = 0;
+    popupVisible = false;
     radio.setFSKRxEnabled(true);
 }
 
@@ -25,24 +27,27 @@ void Messenger::update(void) {
     while (radio.popFSKMessage(rxBuf, sizeof(rxBuf))) {
         addLog("< ", rxBuf);
         recallIndex = -1;
+        invalidate();
+    }
+    // The multi-tap popup goes away on its own
+    if (popupVisible && (getElapsedMilliseconds() - lastKeyTime) >= MULTITAP_TIMEOUT_MS) {
+        popupVisible = false;
+        invalidate();
     }
-    drawScreen();
 }
 
 void Messenger::timeout(void) {
     // TODO : handle timeout events if needed
 }
 
-void Messenger::drawScreen() {
-    ui.clearDisplay();
+void Messenger::render(void) {
     ui.setBlackColor();
     ui.lcd()->drawBox(0, 0, 128, 7);
     //ui.lcd()->drawHLine(0, 55, 128);
     ui.lcd()->drawBox(0, 56, 128, 8);
     ui.setFont(Font::FONT_8B_TR);
     ui.drawString(TextAlign::LEFT, 2, 0, 6, false, false, false, "MESSENGER");
-    ui.drawStringf(TextAlign::RIGHT, 0, 126, 6, false, false, false, "-%s-",
-        (inputMode == InputMode::Upper ? "ABC" : "123"));
+    ui.drawString(TextAlign::RIGHT, 0, 126, 6, false, false, false, inputMode == InputMode::Upper ? "-ABC-" : "-123-");
 
     ui.setFont(Font::FONT_5_TR);
     //ui.setBlackColor();
@@ -57,11 +62,11 @@ void Messenger::drawScreen() {
     ui.setFont(Font::FONT_8_TR);
     // draw text with trailing cursor underscore
     char displayBuf[MAX_MSG_LEN + 2] = {0};
-    snprintf(displayBuf, sizeof(displayBuf), "%s_", inputBuffer.data());
+    Fmt::format(displayBuf, sizeof(displayBuf), inputBuffer.data(), '_');
     ui.drawString(TextAlign::LEFT, 2, 0, 62, false, false, false, displayBuf);
 
     // Popup with available characters and current selection
-    if (popupLen > 0 && (getElapsedMilliseconds() - lastKeyTime) < MULTITAP_TIMEOUT_MS) {
+    if (popupVisible) {
         ui.setFont(Font::FONT_8_TR);
         uint8_t x = 4;
         const uint8_t y = 53;
@@ -86,15 +91,13 @@ void Messenger::drawScreen() {
             x = static_cast<uint8_t>(x + w + 3);
         }
     }
-
-    ui.updateDisplay();
 }
 
 void Messenger::addLog(const char* prefix, const char* text) {
     if (!text || !prefix) return;
 
     std::array<char, MAX_MSG_LEN> combined{};
-    snprintf(combined.data(), combined.size(), "%s%s", prefix, text);
+    Fmt::format(combined.data(), combined.size(), prefix, text);
 
     if (logCount < MAX_LOG_LINES) {
         logLines[logCount++] = combined;
@@ -161,6 +164,7 @@ void Messenger::handleInputKey(Keyboard::KeyCode key) {
     } else {
         popupLen = 0;
     }
+    popupVisible = popupLen > 0;
     lastKeyCycle = cycle;
     lastKey = key;
     lastKeyTime = now;
@@ -176,6 +180,7 @@ void Messenger::backspace() {
     lastKeyCycle = 0;
     lastKeyTime = 0;
     popupLen = 0;
+    popupVisible = false;
 }
 
 void Messenger::sendMessage() {
@@ -14,6 +14,7 @@ namespace Applications {
 
         void init(void) override;
         void update(void) override;
+        void render(void) override;
         void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) override;
         void timeout(void) override;
 
@@ -40,7 +41,6 @@ namespace Applications {
         uint8_t popupLen = 0;
         bool popupVisible = false;
 
-        void drawScreen();
         void addLog(const char* prefix, const char* text);
         void handleInputKey(Keyboard::KeyCode key);
         const char* keyChars(Keyboard::KeyCode key) const;
@@ -10,9 +10,7 @@ using namespace Applications;
 
 //const uint8_t text1[] = { 0x4C, 0x71, 0x1A, 0x10, 0x43, 0xD1, 0x38, 0xC6, 0x82, 0x38, 0xD4, 0xC4, 0x35, 0x36, 0x88, 0x49, 0xA2, 0x0D, 0x08, 0xE3, 0x0F, 0x01, 0x32, 0x01, 0x2C, 0x46, 0xDA, 0x4C, 0xE6, 0x94, 0x48, 0x46, 0x80, 0x2C, 0xB6, 0x85, 0x10, 0x04, 0xD4, 0x44, 0x44, 0x9C, 0x68, 0x84, 0xDA, 0x31, 0x44, 0x93, 0x68, 0x11, 0x1A, 0x20, 0xD2, 0x13, 0x20, 0x02, 0xC8, 0x64, 0x40, 0xDB, 0x69, 0x31, 0xC8, 0x49, 0xA0, 0x02, 0x4C, 0x83, 0x8D, 0x69, 0x62, 0x0B, 0x2D, 0xA1, 0x11, 0x01, 0x21, 0x1A, 0x00, 0xB2, 0xDA, 0x09, 0x44, 0x51, 0x10, 0xD4, 0xDA, 0x0C, 0x04, 0xC0, 0x6D, 0xA3, 0x00, 0x28, 0x46, 0x80, 0x68, 0x10, 0x02, 0x29, 0x43, 0xDA, 0x04, 0x41, 0x4E, 0x44, 0x46, 0x82, 0x38, 0xD4, 0xC8, 0x35, 0x42, 0x0D, 0x19, 0xB0 } /* ("THE EEPROM CONTENT IS INCOMPATIBLE. TO USE ALL FEATURES, IT MUST BE INITIALIZED. THIS ACTION WILL ERASE ALL CURRENT DATA. MAKE A BACKUP BEFORE CONTINUING.") */;
 
-void ResetInit::drawScreen(void) {
-
-    ui.clearDisplay();
+void ResetInit::render(void) {
 
     ui.lcd()->setColorIndex(BLACK);
 
@@ -24,7 +22,7 @@ void ResetInit::drawScreen(void) {
         u8g2_uint_t barWidth = (u8g2_uint_t)((initProgress * 120) / 100);
         ui.lcd()->drawFrame(4, 20, 120, 10);
         ui.lcd()->drawBox(4, 20, barWidth, 10);
-        ui.drawStringf(TextAlign::CENTER, 0, 128, 46, true, false, false, "%d%%", initProgress);
+        ui.drawText(TextAlign::CENTER, 0, 128, 46, true, false, false, Fmt::percent(initProgress));
         if (isReady) {
             ui.drawString(TextAlign::CENTER, 0, 128, 36, true, false, false, "DONE");
         }
@@ -45,7 +43,7 @@ void ResetInit::drawScreen(void) {
             ui.drawPopupWindow(15, 20, 96, 32, "Init. EEPROM ?");
             ui.setFont(Font::FONT_8_TR);
             ui.drawString(TextAlign::CENTER, 17, 111, 36, true, false, false, "Press 1 to accept.");
-            ui.drawStringf(TextAlign::CENTER, 17, 111, 46, true, false, false, "%s to cancel.", isInit ? "Other key" : "EXIT");            
+            ui.drawString(TextAlign::CENTER, 17, 111, 46, true, false, false, isInit ? "Other key to cancel." : "EXIT to cancel.");            
         }
     }
 
@@ -53,8 +51,6 @@ void ResetInit::drawScreen(void) {
 
     ui.lcd()->drawBox(0, 57, 128, 7);
     ui.drawString(TextAlign::CENTER, 0, 128, 63, false, false, false, AUTHOR_STRING " - " VERSION_STRING);
-
-    ui.updateDisplay();
 }
 
 
@@ -65,12 +61,14 @@ void ResetInit::update(void) {
     if (isToInitialize) {
         if (initProgress < 100) {            
             initProgress = settings.initEEPROM();
+            // One EEPROM block per update, keep them coming
+            systask.requestFrameBoost();
         }
         else {
             isReady = true;
         }
+        invalidate();
     }
-    drawScreen();
 }
 
 void ResetInit::timeout(void) {
@@ -12,7 +12,7 @@ namespace Applications
         ResetInit(System::SystemTask& systask, UI& ui, Settings& settings, bool isInit = true) 
             : Application(systask, ui), settings{ settings }, isInit{ isInit } {};
 
-        void drawScreen(void);
+        void render(void);
         void init(void);
         void update(void);
         void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState);
@@ -7,9 +7,9 @@
 
 using namespace Applications;
 
-void SetRadio::drawScreen(void) {
+static constexpr OptionTable<"MIC DB\nBATT SAVE\nBUSY LOCKOUT\nBLIGHT LEVEL\nBLIGHT TIME\nBLIGHT MODE\nLCD CONTRAST\nTX TOT\nBEEP\nRESET"> MENU_ITEMS{};
 
-    ui.clearDisplay();
+void SetRadio::render(void) {
 
     ui.setBlackColor();
 
@@ -17,7 +17,7 @@ void SetRadio::drawScreen(void) {
     
     ui.setFont(Font::FONT_8B_TR);
     ui.drawString(TextAlign::LEFT, 2, 0, 6, false, false, false, "RADIO");
-    ui.drawStringf(TextAlign::RIGHT, 0, 126, 6, false, false, false, "%02u / %02u", menulist.getListPos() + 1, menulist.getTotal());
+    ui.drawText(TextAlign::RIGHT, 0, 126, 6, false, false, false, Fmt::zero<2>(menulist.getListPos() + 1), " / ", Fmt::zero<2>(menulist.getTotal()));
 
     ui.setBlackColor();
 
@@ -27,18 +27,13 @@ void SetRadio::drawScreen(void) {
     if (optionSelected != 0) {
         optionlist.drawPopup(ui, true);
     }
-
-    ui.updateDisplay();
 }
 
 
 void SetRadio::init(void) {
-    menulist.set(0, 6, 127, "MIC DB\nBATT SAVE\nBUSY LOCKOUT\nBLIGHT LEVEL\nBLIGHT TIME\nBLIGHT MODE\nLCD CONTRAST\nTX TOT\nBEEP\nRESET");
+    menulist.set(0, 6, 127, MENU_ITEMS);
 }
 
-void SetRadio::update(void) {
-    drawScreen();
-}
 
 void SetRadio::timeout(void) {
     settings.scheduleSaveIfNeeded();
@@ -48,23 +43,23 @@ void SetRadio::timeout(void) {
 const char* SetRadio::getCurrentOption() {
     switch (menulist.getListPos() + 1) {
     case 1:
-        return ui.getStrValue(Settings::MicDBStr, (uint8_t)settings.radioSettings.micDB - 1);
+        return Settings::MicDBStr.get((uint8_t)settings.radioSettings.micDB - 1);
     case 2:
-        return ui.getStrValue(Settings::onoffStr, (uint8_t)settings.radioSettings.batterySave);
+        return Settings::onoffStr.get((uint8_t)settings.radioSettings.batterySave);
     case 3:
-        return ui.getStrValue(Settings::onoffStr, (uint8_t)settings.radioSettings.busyLockout);
+        return Settings::onoffStr.get((uint8_t)settings.radioSettings.busyLockout);
     case 4:
-        return ui.getStrValue(Settings::BacklightLevelStr, settings.radioSettings.backlightLevel);
+        return Settings::BacklightLevelStr.get(settings.radioSettings.backlightLevel);
     case 5:
-        return ui.getStrValue(Settings::BacklightTimeStr, (uint8_t)settings.radioSettings.backlightTime);
+        return Settings::BacklightTimeStr.get((uint8_t)settings.radioSettings.backlightTime);
     case 6:
-        return ui.getStrValue(Settings::BacklightModeStr, (uint8_t)settings.radioSettings.backlightMode);
+        return Settings::BacklightModeStr.get((uint8_t)settings.radioSettings.backlightMode);
     case 7:
-        return ui.getStrValue(Settings::LCDContrastStr, settings.radioSettings.lcdContrast);
+        return Settings::LCDContrastStr.get(settings.radioSettings.lcdContrast);
     case 8:
-        return ui.getStrValue(Settings::TXTimeoutStr, (uint8_t)settings.radioSettings.txTOT);
+        return Settings::TXTimeoutStr.get((uint8_t)settings.radioSettings.txTOT);
     case 9:
-        return ui.getStrValue(Settings::onoffStr, (uint8_t)settings.radioSettings.beep);
+        return Settings::onoffStr.get((uint8_t)settings.radioSettings.beep);
     default:
         return NULL;
     }
@@ -165,7 +160,7 @@ void SetRadio::action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) {
                     systask.pushMessage(System::SystemTask::SystemMSG::MSG_APP_LOAD, (uint32_t)Applications::RESETEEPROM);
                 } else {
                     optionSelected = idx;
-                    optionlist.setPopupTitle(menulist.getStringLine());
+                    optionlist.setPopupTitle(MENU_ITEMS.get(menulist.getListPos()));
                     loadOptions();
                 }
              } else if (keyCode >= Keyboard::KeyCode::KEY_0 &&
@@ -19,9 +19,8 @@ namespace Applications
             : Application(systask, ui), menulist(ui), optionlist(ui), settings{ settings } {
         }
 
-        void drawScreen(void);
+        void render(void);
         void init(void);
-        void update(void);
         void timeout(void);
         void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState);
 
@@ -4,24 +4,26 @@
 #include "set_vfo.h"
 #include "system.h"
 #include "ui.h"
+#include "code_labels.h"
 #include "u8g2.h"
 
 using namespace Applications;
 
 static constexpr uint32_t MAX_OFFSET_INPUT = 1000000U; // 10 MHz in 10 Hz units
+static constexpr OptionTable<"SQUELCH\nSTEP\nMODE\nBANDWIDTH\nTX POWER\nSHIFT\nOFFSET\nRX CODE TYPE\nRX CODE\nTX CODE TYPE\nTX CODE\nTX STE\nRX STE\nCOMPANDER\nRX ACG\nPTT ID\nROGER"> MENU_ITEMS{};
 
 const char* SetVFO::codeValue(Settings::CodeType type, uint8_t code, SelectionList& list)
 {
     switch (type) {
     case Settings::CodeType::CT:
         list.setSuffix(ui.HZStr);
-        return ui.getStrValue(ui.generateCTDCList(Settings::CTCSSOptions, 50), code);
+        return CodeLabels::CTCSS.get(code);
     case Settings::CodeType::DCS:
         list.setSuffix("I");
-        return ui.getStrValue(ui.generateCTDCList(Settings::DCSOptions, 104, false), code);
+        return CodeLabels::DCS.get(code);
     case Settings::CodeType::NDCS:
         list.setSuffix("N");
-        return ui.getStrValue(ui.generateCTDCList(Settings::DCSOptions, 104, false), code);
+        return CodeLabels::DCS.get(code);
     default:
         return nullptr;
     }
@@ -31,30 +33,28 @@ bool SetVFO::configureCodeList(Settings::CodeType type, uint8_t code)
 {
     switch (type) {
     case Settings::CodeType::CT:
-        optionlist.set(code, 5, 0, ui.generateCTDCList(Settings::CTCSSOptions, 50), ui.HZStr);
+        optionlist.set(code, 5, 0, CodeLabels::CTCSSItems, ui.HZStr);
         return true;
     case Settings::CodeType::DCS:
-        optionlist.set(code, 5, 0, ui.generateCTDCList(Settings::DCSOptions, 104, false), "I");
+        optionlist.set(code, 5, 0, CodeLabels::DCSItems, "I");
         return true;
     case Settings::CodeType::NDCS:
-        optionlist.set(code, 5, 0, ui.generateCTDCList(Settings::DCSOptions, 104, false), "N");
+        optionlist.set(code, 5, 0, CodeLabels::DCSItems, "N");
         return true;
     default:
         return false;
     }
 }
 
-void SetVFO::drawScreen(void) {
-
-    ui.clearDisplay();
+void SetVFO::render(void) {
 
     ui.setBlackColor();
 
     ui.lcd()->drawBox(0, 0, 128, 7);
 
     ui.setFont(Font::FONT_8B_TR);
-    ui.drawStringf(TextAlign::LEFT, 2, 0, 6, false, false, false, "%s %s", ui.VFOStr, vfoab == Settings::VFOAB::VFOA ? "A" : "B");
-    ui.drawStringf(TextAlign::RIGHT, 0, 126, 6, false, false, false, "%02u / %02u", menulist.getListPos() + 1, menulist.getTotal());
+    ui.drawText(TextAlign::LEFT, 2, 0, 6, false, false, false, ui.VFOStr, vfoab == Settings::VFOAB::VFOA ? " A" : " B");
+    ui.drawText(TextAlign::RIGHT, 0, 126, 6, false, false, false, Fmt::zero<2>(menulist.getListPos() + 1), " / ", Fmt::zero<2>(menulist.getTotal()));
 
     ui.setBlackColor();
 
@@ -65,23 +65,18 @@ void SetVFO::drawScreen(void) {
     }
     if (userOptionSelected != 0) {
         // display user input
-        ui.drawPopupWindow(36, 15, 90, 34, menulist.getStringLine());
+        ui.drawPopupWindow(36, 15, 90, 34, MENU_ITEMS.get(menulist.getListPos()));
         ui.drawFrequencySmall(false, userOptionInput, 122, 37);
     }
-
-    ui.updateDisplay();
 }
 
 void SetVFO::init(void) {
-    menulist.set(0, 6, 127, "SQUELCH\nSTEP\nMODE\nBANDWIDTH\nTX POWER\nSHIFT\nOFFSET\nRX CODE TYPE\nRX CODE\nTX CODE TYPE\nTX CODE\nTX STE\nRX STE\nCOMPANDER\nRX ACG\nPTT ID\nROGER");
+    menulist.set(0, 6, 127, MENU_ITEMS);
     vfo = radio.getVFO(vfoab);
     originalVfo = vfo;
     modified = false;
 }
 
-void SetVFO::update(void) {
-    drawScreen();
-}
 
 void SetVFO::timeout(void) {
     if (optionSelected == 0 && userOptionSelected == 0) {
@@ -98,19 +93,19 @@ const char* SetVFO::getCurrentOption() {
     menulist.setSuffix(NULL);
     switch (menulist.getListPos() + 1) {
     case 1: // SQUELCH
-        return ui.getStrValue(Settings::squelchStr, (uint8_t)vfo.squelch);
+        return Settings::squelchStr.get((uint8_t)vfo.squelch);
     case 2: // STEP
         menulist.setSuffix(ui.KHZStr);
-        return ui.getStrValue(Settings::stepStr, (uint8_t)vfo.step);
+        return Settings::stepStr.get((uint8_t)vfo.step);
     case 3: // MODE
-        return ui.getStrValue(Settings::modulationStr, (uint8_t)vfo.modulation);
+        return Settings::modulationStr.get((uint8_t)vfo.modulation);
     case 4: // BANDWIDTH
         menulist.setSuffix(ui.KHZStr);
-        return ui.getStrValue(Settings::bandwidthStr, (uint8_t)vfo.bw);
+        return Settings::bandwidthStr.get((uint8_t)vfo.bw);
     case 5: // TX POWER
-        return ui.getStrValue(Settings::powerStr, (uint8_t)vfo.power);
+        return Settings::powerStr.get((uint8_t)vfo.power);
     case 6: // SHIFT
-        return ui.getStrValue(Settings::offsetStr, (uint8_t)vfo.shift);
+        return Settings::offsetStr.get((uint8_t)vfo.shift);
     case 7: // OFFSET
         if (vfo.rx.frequency >= vfo.tx.frequency) {
             return ui.getFrequencyString(vfo.rx.frequency - vfo.tx.frequency, 0, true);
@@ -118,28 +113,28 @@ const char* SetVFO::getCurrentOption() {
             return ui.getFrequencyString(vfo.tx.frequency - vfo.rx.frequency, 0, true);
         }
     case 8: // RX CODE TYPE
-        return ui.getStrValue(Settings::codetypeStr, (uint8_t)vfo.rx.codeType);
+        return Settings::codetypeStr.get((uint8_t)vfo.rx.codeType);
     case 10: // TX CODE TYPE
-        return ui.getStrValue(Settings::codetypeStr, (uint8_t)vfo.tx.codeType);
+        return Settings::codetypeStr.get((uint8_t)vfo.tx.codeType);
     case 9: // RX CODE
         return codeValue(vfo.rx.codeType, vfo.rx.code, menulist);
     case 11: // TX CODE
         return codeValue(vfo.tx.codeType, vfo.tx.code, menulist);
     case 12: // TX STE
-        return ui.getStrValue(Settings::onoffStr, (uint8_t)vfo.repeaterSte);
+        return Settings::onoffStr.get((uint8_t)vfo.repeaterSte);
     case 13: // RX STE
-        return ui.getStrValue(Settings::onoffStr, (uint8_t)vfo.ste);
+        return Settings::onoffStr.get((uint8_t)vfo.ste);
     case 14: // COMPANDER
-        return ui.getStrValue(Settings::txrxStr, (uint8_t)vfo.compander);    
+        return Settings::txrxStr.get((uint8_t)vfo.compander);    
     case 15: // RX ACG
-        if (vfo.rxagc < ui.stringLengthNL(Settings::AGCStr) - 1) {
+        if (vfo.rxagc < Settings::AGCStr.COUNT - 1) {
             menulist.setSuffix(ui.DBStr);
         }
-        return ui.getStrValue(Settings::AGCStr, (uint8_t)vfo.rxagc);
+        return Settings::AGCStr.get((uint8_t)vfo.rxagc);
     case 16: // PTT ID
-        return ui.getStrValue(Settings::pttIDStr, (uint8_t)vfo.pttid);
+        return Settings::pttIDStr.get((uint8_t)vfo.pttid);
     case 17: // ROGER
-        return ui.getStrValue(Settings::rogerStr, (uint8_t)vfo.roger);
+        return Settings::rogerStr.get((uint8_t)vfo.roger);
     default:
         return NULL;
     }
@@ -332,7 +327,7 @@ void SetVFO::action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState) {
                         }
                     } else {
                         optionSelected = optionListSelected;
-                        optionlist.setPopupTitle(menulist.getStringLine());
+                        optionlist.setPopupTitle(MENU_ITEMS.get(menulist.getListPos()));
                     }
                     loadOptions();
                 }
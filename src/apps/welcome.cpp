@@ -8,9 +8,7 @@
 
 using namespace Applications;
 
-void Welcome::drawScreen(void) {
-
-    ui.clearDisplay();
+void Welcome::render(void) {
 
     ui.lcd()->setColorIndex(BLACK);
 
@@ -23,7 +21,7 @@ void Welcome::drawScreen(void) {
     ui.drawBattery(systask.getBattery().getBatteryPercentage(), 20, 30);
 
     ui.setFont(Font::FONT_8_TR);
-    ui.drawStrf(8, 42, "%i%% %u.%02uV", systask.getBattery().getBatteryPercentage(), systask.getBattery().getBatteryVoltageAverage() / 100, systask.getBattery().getBatteryVoltageAverage() % 100);
+    ui.lcd()->drawStr(8, 42, Fmt::Text<16>(Fmt::percent(systask.getBattery().getBatteryPercentage()), ' ', Fmt::fixed<2>(systask.getBattery().getBatteryVoltageAverage()), 'V'));
 
     //ui.lcd()->drawStr(64, 33, "SI4732");
     ui.lcd()->drawStr(64, 42, "EEPROM");
@@ -40,17 +38,12 @@ void Welcome::drawScreen(void) {
 
     ui.lcd()->drawBox(0, 57, 128, 7);
     ui.drawString(TextAlign::CENTER, 0, 128, 63, false, false, false, AUTHOR_STRING " - " VERSION_STRING);
-
-    ui.updateDisplay();
 }
 
 
 void Welcome::init(void) {    
 }
 
-void Welcome::update(void) {
-    drawScreen();
-}
 
 void Welcome::timeout(void) {
     systask.pushMessage(System::SystemTask::SystemMSG::MSG_APP_LOAD, (uint32_t)Applications::MainVFO);
@@ -12,9 +12,8 @@ namespace Applications
             : Application(systask, ui) {
         }
 
-        void drawScreen(void);
+        void render(void);
         void init(void);
-        void update(void);
         void action(Keyboard::KeyCode keyCode, Keyboard::KeyState keyState);
         void timeout(void);
 
@@ -36,6 +36,8 @@ static const RegisterSpec RS_RF_FILT_BW_WEAK = {"RF BWw", 0x43, 9, 0b111,
 static const RegisterSpec RS_BW_MODE = {"BW Mode", 0x43, 4, 0b11, 1};
 static const RegisterSpec RS_IF_F = {"IF", 0x3D, 0, 0xFFFF, 1};
 static const RegisterSpec RS_SQ_TYPE = {"SQ type", 0x77, 8, 0xFF, 1};
+static const RegisterSpec RS_AGC_FIXED = {"AGC Fix", 0x7E, 15, 1, 1};
+static const RegisterSpec RS_AGC_FIX_INDEX = {"AGC Idx", 0x7E, 12, 0b111, 1};
 
 enum BK4819_REGISTER_t {
 	BK4819_REG_00 = 0x00U, // Soft reset: 0x00: reset, 0x01: normal
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <utility>
 
 #include "sys.h"
@@ -78,21 +79,98 @@ public:
 class BK4819 {
 public:
 
+    // The register writes that configure the chip for one VFO, recorded once
+    // by beginProfile() / endProfile() and replayed on every VFO switch
+    struct RegisterProfile {
+        static constexpr uint8_t MAX_WRITES = 40;
+
+        bool valid = false;
+        uint8_t epoch = 0;      // see isProfileCurrent()
+        uint8_t count = 0;
+        uint8_t regs[MAX_WRITES];
+        uint16_t values[MAX_WRITES];
+    };
+
+    // Batches register updates. Field updates to one register merge, and
+    // commit() writes each touched register once, in the order first
+    // touched. Registers where every write is an action (isCommandRegister)
+    // keep all their writes, in order.
+    //
+    //     auto tx = bk4819.begin();
+    //     tx.set(RS_IF_F, 10923);
+    //     tx.commit();
+    class Transaction {
+    public:
+        explicit Transaction(BK4819& chip) : chip{ chip } {}
+
+        Transaction& set(RegisterSpec s, uint16_t v) {
+            return update(s.num, (uint16_t)(s.mask << s.offset), (uint16_t)(v << s.offset));
+        }
+
+        Transaction& write(uint8_t reg, uint16_t value) {
+            return update(reg, 0xFFFF, value);
+        }
+
+        void commit(void) {
+            for (uint8_t i = 0; i < count; i++) {
+                uint16_t value = bits[i];
+                if (masks[i] != 0xFFFF) {
+                    value = (uint16_t)(value | (chip.readRegister(regs[i]) & ~masks[i]));
+                }
+                chip.writeRegister(regs[i], value);
+            }
+            count = 0;
+        }
+
+    private:
+        static constexpr uint8_t MAX_REGISTERS = 16;
+
+        BK4819& chip;
+        uint8_t count = 0;
+        uint8_t regs[MAX_REGISTERS];
+        uint16_t masks[MAX_REGISTERS];
+        uint16_t bits[MAX_REGISTERS];
+
+        Transaction& update(uint8_t reg, uint16_t mask, uint16_t value) {
+            value &= mask;
+            if (!isCommandRegister(reg)) {
+                for (uint8_t i = 0; i < count; i++) {
+                    if (regs[i] == reg) {
+                        masks[i] |= mask;
+                        bits[i] = (uint16_t)((bits[i] & ~mask) | value);
+                        return *this;
+                    }
+                }
+            }
+            if (count == MAX_REGISTERS) {
+                commit(); // keeps the order, only merges less
+            }
+            regs[count] = reg;
+            masks[count] = mask;
+            bits[count++] = value;
+            return *this;
+        }
+    };
+
     BK4819() {
         initializeChip();
     }
 
+    Transaction begin(void) {
+        return Transaction(*this);
+    }
+
     void initializeChip() {
 
         // Perform a soft reset
         softReset();
 
         // Clear any pending interrupts
-        spi.writeRegister(BK4819_REG_02, 0x0000);
-        spi.writeRegister(BK4819_REG_3F, 0x0000);
+        writeRegister(BK4819_REG_02, 0x0000);
+        writeRegister(BK4819_REG_3F, 0x0000);
 
         // Disable unnecessary components
-        spi.writeRegister(BK4819_REG_30,
+        writeRegister(BK4819_REG_30,
             BK4819_REG_30_DISABLE_VCO_CALIB |
             BK4819_REG_30_DISABLE_RX_LINK |
             BK4819_REG_30_DISABLE_AF_DAC |
@@ -118,30 +196,30 @@ public:
             REG_37<1>       0   XTAL enable: 1: Enable / 0: Disable
             REG_37<0>       0   Band Gap enable: 1: Enable / 0: Disable
         */
-        spi.writeRegister(BK4819_REG_37, 0x1D0F); // 0001110100001111
+        writeRegister(BK4819_REG_37, 0x1D0F); // 0001110100001111
         // PA
-        spi.writeRegister(BK4819_REG_36, 0x0022);
+        writeRegister(BK4819_REG_36, 0x0022);
 
         // Set GPIO state
         gpioOutState = 0x9000;
-        spi.writeRegister(BK4819_REG_33, gpioOutState);
-        //spi.writeRegister(BK4819_REG_3F, 0);
+        writeRegister(BK4819_REG_33, gpioOutState);
+        //writeRegister(BK4819_REG_3F, 0);
 
         setAGC(true, false, 18);
 
         //Automatic MIC PGA Gain Controller
-        spi.writeRegister(BK4819_REG_19, 0x1041);
+        writeRegister(BK4819_REG_19, 0x1041);
         // MIC sensitivity
-        spi.writeRegister(BK4819_REG_7D, 0xE94F);
+        writeRegister(BK4819_REG_7D, 0xE94F);
         // AF
-        //spi.writeRegister(BK4819_REG_48, 0xB3A8);
+        //writeRegister(BK4819_REG_48, 0xB3A8);
 
         // DTMF_COEFFS ???
 
         // RF
-        spi.writeRegister(BK4819_REG_1F, 0x5454);
+        writeRegister(BK4819_REG_1F, 0x5454);
         // Band selection threshold
-        spi.writeRegister(BK4819_REG_3E, 0xA037);
+        writeRegister(BK4819_REG_3E, 0xA037);
 
         // Set GPIO5<1> to high - RED
         //toggleGpioOut(gPIO5_PIN1_RED, true);
@@ -159,15 +237,15 @@ public:
 
         // setFilterBandwidth(BK4819_FILTER_BW_WIDE);
 
-        while (spi.readRegister(BK4819_REG_0C) & 1U) {
-            spi.writeRegister(BK4819_REG_02, 0);
+        while (readRegister(BK4819_REG_0C) & 1U) {
+            writeRegister(BK4819_REG_02, 0);
             delayMs(1);
         }
-        spi.writeRegister(BK4819_REG_3F, 0);
-        spi.writeRegister(BK4819_REG_7D, 0xE94F | 10); // mic
+        writeRegister(BK4819_REG_3F, 0);
+        writeRegister(BK4819_REG_7D, 0xE94F | 10); // mic
         // TX
-        // spi.writeRegister(0x44, 38888);  // 300 resp TX
-        spi.writeRegister(BK4819_REG_74, 0xAF1F); // 3k resp TX
+        // writeRegister(0x44, 38888);  // 300 resp TX
+        writeRegister(BK4819_REG_74, 0xAF1F); // 3k resp TX
 
         toggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, true);
 
@@ -189,7 +267,7 @@ public:
         //         15 = max
         //          0 = min
         //
-        spi.writeRegister(BK4819_REG_48, //  0xB3A8);     // 1011 00 111010 1000
+        writeRegister(BK4819_REG_48, //  0xB3A8);     // 1011 00 111010 1000
             (11u << 12) |     // ??? 0..15
             (1u << 10) |     // AF Rx Gain-1 (-6 dB to soften highs)
             (54u << 4) |     // AF Rx Gain-2
@@ -206,45 +284,48 @@ public:
             BK4819_REG_3F_DTMF_5TONE_FOUND |
             BK4819_REG_3F_CxCSS_TAIL;
 
-        spi.writeRegister(BK4819_REG_3F, InterruptMask);*/
+        writeRegister(BK4819_REG_3F, InterruptMask);*/
 
-        spi.writeRegister(BK4819_REG_40, (spi.readRegister(BK4819_REG_40) & ~(0b11111111111)) |
+        writeRegister(BK4819_REG_40, (readRegister(BK4819_REG_40) & ~(0b11111111111)) |
             1000 | (1 << 12));
-        // spi.writeRegister(BK4819_REG_40, (1 << 12) | (1450));
+        // writeRegister(BK4819_REG_40, (1 << 12) | (1450));
+
+        // What VFO profiles are recorded against
+        memcpy(baselineRegs, shadowRegs, sizeof(baselineRegs));
+        memcpy(baselineValid, shadowValid, sizeof(baselineValid));
     }
 
-    void initAGC(bool amModulation) {
+    void initAGC(Transaction& tx, bool amModulation) {
         // Gain table remains the same for FM and AM, thresholds change
-        spi.writeRegister(BK4819_REG_13, 0x03BE);
-        spi.writeRegister(BK4819_REG_12, 0x037B);
-        spi.writeRegister(BK4819_REG_11, 0x027B);
-        spi.writeRegister(BK4819_REG_10, 0x007A);
+        tx.write(BK4819_REG_13, 0x03BE);
+        tx.write(BK4819_REG_12, 0x037B);
+        tx.write(BK4819_REG_11, 0x027B);
+        tx.write(BK4819_REG_10, 0x007A);
 
         const uint16_t highThresh = amModulation ? 50 : 84;
         const uint16_t lowThresh  = amModulation ? 32 : 56;
         const uint16_t reg14      = amModulation ? 0x0000 : 0x0019;
 
-        spi.writeRegister(BK4819_REG_14, reg14);
-        spi.writeRegister(BK4819_REG_49, static_cast<uint16_t>((0u << 14) | (highThresh << 7) | (lowThresh << 0)));
-        spi.writeRegister(BK4819_REG_7B, 0x8420);
+        tx.write(BK4819_REG_14, reg14);
+        tx.write(BK4819_REG_49, static_cast<uint16_t>((0u << 14) | (highThresh << 7) | (lowThresh << 0)));
+        tx.write(BK4819_REG_7B, 0x8420);
     }
 
     void setAGC(bool enable, bool amModulation, uint8_t gainIndex = 18) {
-        initAGC(amModulation);
+        Transaction tx = begin();
+        initAGC(tx, amModulation);
 
         const uint8_t GAIN_AUTO = 18;
         const bool useAutoGain = enable && gainIndex == GAIN_AUTO;
 
-        uint16_t regVal = spi.readRegister(BK4819_REG_7E);
-        regVal &= static_cast<uint16_t>(~((1u << 15) | (0b111u << 12)));
-        regVal |= static_cast<uint16_t>((!useAutoGain ? 1u : 0u) << 15);   // 0 = AGC on, 1 = fixed gain
-        regVal |= static_cast<uint16_t>(3u << 12);                        // fixed gain index placeholder
-        spi.writeRegister(BK4819_REG_7E, regVal);
+        tx.set(RS_AGC_FIXED, !useAutoGain ? 1u : 0u);   // 0 = AGC on, 1 = fixed gain
+        tx.set(RS_AGC_FIX_INDEX, 3u);                   // fixed gain index placeholder
 
         if (!useAutoGain && gainIndex < (sizeof(gainTable) / sizeof(gainTable[0]))) {
-            spi.writeRegister(BK4819_REG_13,
+            tx.write(BK4819_REG_13,
                 static_cast<uint16_t>(gainTable[gainIndex] | 6 | (3 << 3)));
         }
+        tx.commit();
     }
 
     void setFilterBandwidth(BK4819_Filter_Bandwidth bw, bool keepWeakSame = false) {
@@ -264,7 +345,7 @@ public:
             val = keepWeakSame ? 0x1348 : 0x1148; // 6.25 kHz style profile
         }
 
-        spi.writeRegister(BK4819_REG_43, val);
+        writeRegister(BK4819_REG_43, val);
     }
 
     void squelchType(SquelchType t) {
@@ -274,39 +355,39 @@ public:
     void tuneTo(uint32_t frequency, bool precise) {
         selectFilter(frequency);
         setFrequency(frequency);
-        uint16_t reg = spi.readRegister(BK4819_REG_30);
+        uint16_t reg = readRegister(BK4819_REG_30);
         if (precise) {
-            spi.writeRegister(BK4819_REG_30, 0x0200);
-            //spi.writeRegister(BK4819_REG_30, 0x0000);
+            writeRegister(BK4819_REG_30, 0x0200);
+            //writeRegister(BK4819_REG_30, 0x0000);
         }
         else {
-            spi.writeRegister(BK4819_REG_30, reg & ~BK4819_REG_30_ENABLE_VCO_CALIB);
+            writeRegister(BK4819_REG_30, reg & ~BK4819_REG_30_ENABLE_VCO_CALIB);
         }
-        spi.writeRegister(BK4819_REG_30, reg);
+        writeRegister(BK4819_REG_30, reg);
     }
 
     void rxTurnOn(void) {
-        spi.writeRegister(BK4819_REG_37, 0x1F0F);
-        //spi.writeRegister(BK4819_REG_30, 0x0200);
-        spi.writeRegister(BK4819_REG_30, 0x0000);
+        writeRegister(BK4819_REG_37, REG_37_RX_ON);
+        //writeRegister(BK4819_REG_30, 0x0200);
+        writeRegister(BK4819_REG_30, 0x0000);
         delayMs(10);
-        spi.writeRegister(
-            BK4819_REG_30,
-            BK4819_REG_30_ENABLE_VCO_CALIB | BK4819_REG_30_DISABLE_UNKNOWN |
-            BK4819_REG_30_ENABLE_RX_LINK | BK4819_REG_30_ENABLE_AF_DAC |
-            BK4819_REG_30_ENABLE_DISC_MODE | BK4819_REG_30_ENABLE_PLL_VCO |
-            BK4819_REG_30_DISABLE_PA_GAIN | BK4819_REG_30_DISABLE_MIC_ADC |
-            BK4819_REG_30_DISABLE_TX_DSP | BK4819_REG_30_ENABLE_RX_DSP);
+        writeRegister(BK4819_REG_30, REG_30_RX_ON);
+    }
+
+    // rxTurnOn() has run and nothing has powered the receiver down since
+    bool isRxOn(void) const {
+        return shadowHas(BK4819_REG_30) && shadowRegs[BK4819_REG_30] == REG_30_RX_ON &&
+            shadowHas(BK4819_REG_37) && shadowRegs[BK4819_REG_37] == REG_37_RX_ON;
     }
 
     void enableTxPath(void) {
         toggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, false);
         toggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, true);
 
-        spi.writeRegister(BK4819_REG_37, 0x1F0F);
-        spi.writeRegister(BK4819_REG_30, 0x0000);
+        writeRegister(BK4819_REG_37, 0x1F0F);
+        writeRegister(BK4819_REG_30, 0x0000);
         delayMs(10);
-        spi.writeRegister(
+        writeRegister(
             BK4819_REG_30,
             BK4819_REG_30_ENABLE_VCO_CALIB | BK4819_REG_30_DISABLE_UNKNOWN |
             BK4819_REG_30_DISABLE_RX_LINK | BK4819_REG_30_ENABLE_AF_DAC |
@@ -318,32 +399,36 @@ public:
     void disableTxPath(void) {
         toggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
         toggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, true);
-        spi.writeRegister(BK4819_REG_30, 0x0000);
+        writeRegister(BK4819_REG_30, 0x0000);
     }
 
     void setAF(BK4819_AF af) {
-        spi.writeRegister(BK4819_REG_47, 0x6040 | ((int)af << 8));
-        //spi.writeRegister(BK4819_REG_47, (6u << 12) | ((int)(af) << 8) | (1u << 6));
+        writeRegister(BK4819_REG_47, afRegValue(af));
+        //writeRegister(BK4819_REG_47, (6u << 12) | ((int)(af) << 8) | (1u << 6));
+    }
+
+    static constexpr uint16_t afRegValue(BK4819_AF af) {
+        return (uint16_t)(0x6040 | ((int)af << 8));
     }
 
     void toggleAFBit(bool on) {
-        uint16_t reg = spi.readRegister(BK4819_REG_47);
+        uint16_t reg = readRegister(BK4819_REG_47);
         reg &= ~(1 << 8);
         if (on)
             reg |= 1 << 8;
-        spi.writeRegister(BK4819_REG_47, reg);
+        writeRegister(BK4819_REG_47, reg);
     }
 
     void toggleAFDAC(bool on) {
-        uint16_t reg = spi.readRegister(BK4819_REG_30);
+        uint16_t reg = readRegister(BK4819_REG_30);
         reg &= ~BK4819_REG_30_ENABLE_AF_DAC;
         if (on)
             reg |= BK4819_REG_30_ENABLE_AF_DAC;
-        spi.writeRegister(BK4819_REG_30, reg);
+        writeRegister(BK4819_REG_30, reg);
     }
 
     bool isSquelchOpen(void) {
-        return (spi.readRegister(BK4819_REG_0C) >> 1) & 1;
+        return (readRegister(BK4819_REG_0C) >> 1) & 1;
     }
 
     // TODO: fix
@@ -357,11 +442,11 @@ public:
     }
 
     void setIdle(void) {
-        spi.writeRegister(BK4819_REG_30, 0x0000);
+        writeRegister(BK4819_REG_30, 0x0000);
     }
 
     void setToneRegister(uint16_t toneConfig) {
-        spi.writeRegister(BK4819_REG_71, toneConfig);
+        writeRegister(BK4819_REG_71, toneConfig);
     }
 
     void setToneFrequency(uint16_t f) {
@@ -369,19 +454,19 @@ public:
     }
 
     void setTone2Frequency(uint16_t f) {
-        spi.writeRegister(BK4819_REG_72, scaleFreq(f));
+        writeRegister(BK4819_REG_72, scaleFreq(f));
     }
 
     void enterTxMute(void) {
-        spi.writeRegister(BK4819_REG_50, 0xBB20);
+        writeRegister(BK4819_REG_50, 0xBB20);
     }
 
     void exitTxMute(void) {
-        spi.writeRegister(BK4819_REG_50, 0x3B20);
+        writeRegister(BK4819_REG_50, 0x3B20);
     }
 
     uint16_t getToneRegister(void) {
-        return spi.readRegister(BK4819_REG_71);
+        return readRegister(BK4819_REG_71);
     }
 
 
@@ -393,10 +478,10 @@ public:
 
         uint16_t toneCfg = BK4819_REG_70_ENABLE_TONE1 |
             (gain << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN);
-        spi.writeRegister(BK4819_REG_70, toneCfg);
+        writeRegister(BK4819_REG_70, toneCfg);
 
         setIdle();
-        spi.writeRegister(BK4819_REG_30, 0 | BK4819_REG_30_ENABLE_AF_DAC |
+        writeRegister(BK4819_REG_30, 0 | BK4819_REG_30_ENABLE_AF_DAC |
             BK4819_REG_30_ENABLE_DISC_MODE |
             BK4819_REG_30_ENABLE_TX_DSP);
 
@@ -404,11 +489,11 @@ public:
     }
 
     void turnsOffTonesTurnsOnRX(void) {
-        spi.writeRegister(BK4819_REG_70, 0);
+        writeRegister(BK4819_REG_70, 0);
         setAF(BK4819_AF::MUTE);
         exitTxMute();
         setIdle();
-        spi.writeRegister(
+        writeRegister(
             BK4819_REG_30, 0 | 
             BK4819_REG_30_ENABLE_VCO_CALIB | 
             BK4819_REG_30_ENABLE_RX_LINK |
@@ -421,83 +506,146 @@ public:
     void setModulation(ModType type) {
         bool isSsb = type == ModType::MOD_LSB || type == ModType::MOD_USB;
         bool isFm = type == ModType::MOD_FM || type == ModType::MOD_WFM;
-        setAF((BK4819_AF)modTypeRegValues[(uint8_t)type]);
-        setRegValue(afDacGainRegSpec, type == ModType::MOD_AM ? 0xA : 0xF);
-        spi.writeRegister(0x3D, isSsb ? 0 : 0x2AAB);
-        setRegValue(afcDisableRegSpec, !isFm);
+        Transaction tx = begin();
+        tx.write(BK4819_REG_47, afRegValue((BK4819_AF)modTypeRegValues[(uint8_t)type]));
+        tx.set(afDacGainRegSpec, type == ModType::MOD_AM ? 0xA : 0xF);
+        tx.write(0x3D, isSsb ? 0 : 0x2AAB);
+        tx.set(afcDisableRegSpec, !isFm);
         if (type == ModType::MOD_WFM) {
-            setRegValue(RS_XTAL_MODE, 0);
-            setRegValue(RS_IF_F, 14223);
-            setRegValue(RS_RF_FILT_BW, 7);
-            setRegValue(RS_RF_FILT_BW_WEAK, 7);
-            setRegValue(RS_BW_MODE, 3);
+            tx.set(RS_XTAL_MODE, 0);
+            tx.set(RS_IF_F, 14223);
+            tx.set(RS_RF_FILT_BW, 7);
+            tx.set(RS_RF_FILT_BW_WEAK, 7);
+            tx.set(RS_BW_MODE, 3);
         }
         else {
-            setRegValue(RS_XTAL_MODE, 2);
-            setRegValue(RS_IF_F, 10923);
+            tx.set(RS_XTAL_MODE, 2);
+            tx.set(RS_IF_F, 10923);
         }
+        tx.commit();
     }
 
     void resetRSSI(void) {
-        uint16_t reg = spi.readRegister(BK4819_REG_30);
+        uint16_t reg = readRegister(BK4819_REG_30);
         reg &= ~1;
-        spi.writeRegister(BK4819_REG_30, reg);
+        writeRegister(BK4819_REG_30, reg);
         reg |= 1;
-        spi.writeRegister(BK4819_REG_30, reg);
+        writeRegister(BK4819_REG_30, reg);
     }
 
     uint16_t getRSSI(void) {
-        return spi.readRegister(BK4819_REG_67) & 0x1FF;
+        return readRegister(BK4819_REG_67) & 0x1FF;
     }
 
     uint8_t getNoise(void) {
-        return (uint8_t)spi.readRegister(BK4819_REG_65) & 0xFF;
+        return (uint8_t)readRegister(BK4819_REG_65) & 0xFF;
     }
 
     uint8_t getRSSIRelative(void) {
-        return static_cast<uint8_t>(spi.readRegister(BK4819_REG_65) >> 8) & 0xFF;
+        return static_cast<uint8_t>(readRegister(BK4819_REG_65) >> 8) & 0xFF;
     }
 
     uint8_t getGlitch(void) {
-        return (uint8_t)spi.readRegister(BK4819_REG_63) & 0xFF;
+        return (uint8_t)readRegister(BK4819_REG_63) & 0xFF;
     }
 
     uint8_t getSNR(void) {
-        return (uint8_t)spi.readRegister(BK4819_REG_61) & 0xFF;
+        return (uint8_t)readRegister(BK4819_REG_61) & 0xFF;
     }
 
     uint16_t getVoiceAmplitude(void) {
-        return spi.readRegister(BK4819_REG_64);
+        return readRegister(BK4819_REG_64);
     }
 
 
     void disableVox(void) {
-        uint16_t v = spi.readRegister(BK4819_REG_31);
-        spi.writeRegister(BK4819_REG_31, v & 0xFFFB);
+        uint16_t v = readRegister(BK4819_REG_31);
+        writeRegister(BK4819_REG_31, v & 0xFFFB);
     }
 
     void disableDTMF(void) {
-        spi.writeRegister(BK4819_REG_24, 0);
+        writeRegister(BK4819_REG_24, 0);
     }
 
     uint16_t getInterruptRequest(void) {
-        return spi.readRegister(BK4819_REG_0C);
+        return readRegister(BK4819_REG_0C);
     }
 
     void clearInterrupt(void) {
-        spi.writeRegister(BK4819_REG_02, 0);
+        writeRegister(BK4819_REG_02, 0);
     }
 
     uint16_t readInterrupt(void) {
-        return spi.readRegister(BK4819_REG_02);
+        return readRegister(BK4819_REG_02);
+    }
+
+    // Low-level accessors (used for FSK TX setup), through the shadow registers
+    uint16_t readRaw(uint8_t reg) { return readRegister(static_cast<BK4819_REGISTER_t>(reg)); }
+    void writeRaw(uint8_t reg, uint16_t val) { writeRegister(static_cast<BK4819_REGISTER_t>(reg), val); }
+
+    // Shadow registers: every write also lands in a copy kept here, so field
+    // updates need no SPI read and writes that would not change a known value
+    // are dropped. Status registers (0x02, 0x0C, 0x3F, 0x67 ...) bypass it.
+
+    // Reads the chip and refreshes the copy, for a register changed behind
+    // the driver's back
+    uint16_t resyncRegister(uint8_t reg) {
+        uint16_t value = spi.readRegister(reg);
+        if (!isStatusRegister(reg)) {
+            shadowStore(reg, value);
+        }
+        return value;
+    }
+
+    // The next access to the register goes to the chip
+    void invalidateRegister(uint8_t reg) {
+        shadowValid[reg >> 5] &= ~(1UL << (reg & 31U));
+    }
+
+    void invalidateRegisters(void) {
+        for (uint32_t& valid : shadowValid) {
+            valid = 0;
+        }
+    }
+
+    // Until endProfile(), writes are recorded into the profile instead of
+    // being sent. Reads see the recorded values, then the registers as
+    // setupRegisters() left them, so nothing the chip holds for another VFO
+    // leaks into the profile through a field update.
+    void beginProfile(RegisterProfile& p) {
+        p.valid = true;
+        p.epoch = profileEpoch;
+        p.count = 0;
+        profile = &p;
+    }
+
+    void endProfile(void) {
+        profile = nullptr;
+    }
+
+    // False once a write outside any profile changed a register profiles
+    // hold (AGC, squelch, power from a menu ...): replaying it would undo
+    // that write, it has to be recorded again
+    bool isProfileCurrent(const RegisterProfile& p) const {
+        return p.valid && p.epoch == profileEpoch;
     }
 
-    // Low-level accessors (used for FSK TX setup)
-    uint16_t readRaw(uint8_t reg) { return spi.readRegister(static_cast<BK4819_REGISTER_t>(reg)); }
-    void writeRaw(uint8_t reg, uint16_t val) { spi.writeRegister(static_cast<BK4819_REGISTER_t>(reg), val); }
+    // Sends the profile; registers already holding their value are skipped
+    // by the shadow copy. False if the profile could not be recorded.
+    bool applyProfile(const RegisterProfile& p) {
+        if (!p.valid) {
+            return false;
+        }
+        applyingProfile = true;
+        for (uint8_t i = 0; i < p.count; i++) {
+            writeRegister(p.regs[i], p.values[i]);
+        }
+        applyingProfile = false;
+        return true;
+    }
 
     void setInterrupt(uint16_t mask) {
-        spi.writeRegister(BK4819_REG_3F, mask);
+        writeRegister(BK4819_REG_3F, mask);
     }
 
     void toggleGreen(bool on) {
@@ -509,7 +657,7 @@ public:
     }
 
     void setCDCSSCodeWord(uint32_t CodeWord) {
-        spi.writeRegister(
+        writeRegister(
             BK4819_REG_51,
             0 | BK4819_REG_51_ENABLE_CxCSS | BK4819_REG_51_GPIO6_PIN2_NORMAL |
             BK4819_REG_51_TX_CDCSS_POSITIVE | BK4819_REG_51_MODE_CDCSS |
@@ -519,13 +667,13 @@ public:
             (51U << BK4819_REG_51_SHIFT_CxCSS_TX_GAIN1));
 
         // CTC1 Frequency Control Word = 2775
-        spi.writeRegister(BK4819_REG_07,
+        writeRegister(BK4819_REG_07,
             0 | BK4819_REG_07_MODE_CTC1 |
             (2775U << BK4819_REG_07_SHIFT_FREQUENCY));
 
         // Set the code word
-        spi.writeRegister(BK4819_REG_08, (CodeWord >> 0) & 0xFFF);
-        spi.writeRegister(BK4819_REG_08, 0x8000 | ((CodeWord >> 12) & 0xFFF));
+        writeRegister(BK4819_REG_08, (CodeWord >> 0) & 0xFFF);
+        writeRegister(BK4819_REG_08, 0x8000 | ((CodeWord >> 12) & 0xFFF));
     }
 
     void setCTCSSFrequency(uint32_t FreqControlWord) {
@@ -548,21 +696,21 @@ public:
             // CTCSS/CDCSS Tx Gain1 Tuning = 74
             Config = 0x904A;
         }
-        spi.writeRegister(BK4819_REG_51, Config);
+        writeRegister(BK4819_REG_51, Config);
         // CTC1 Frequency Control Word
-        spi.writeRegister(BK4819_REG_07, uint16_t(0 | BK4819_REG_07_MODE_CTC1 |
+        writeRegister(BK4819_REG_07, uint16_t(0 | BK4819_REG_07_MODE_CTC1 |
             ((FreqControlWord * 2065) / 1000)
             << BK4819_REG_07_SHIFT_FREQUENCY));
     }
 
     void setTailDetection(const uint32_t freq_10Hz) {
-        spi.writeRegister(BK4819_REG_07,
+        writeRegister(BK4819_REG_07,
             uint16_t(BK4819_REG_07_MODE_CTC2 | ((253910 + (freq_10Hz / 2)) /
                 freq_10Hz))); // with rounding
     }
 
     bool companderEnabled(void) {
-        return (spi.readRegister(BK4819_REG_31) & (1u << 3)) ? true : false;
+        return (readRegister(BK4819_REG_31) & (1u << 3)) ? true : false;
     }
 
     void setCompander(const uint8_t mode) {
@@ -571,10 +719,10 @@ public:
         // mode 2 .. RX
         // mode 3 .. TX and RX
 
-        const uint16_t r31 = spi.readRegister(BK4819_REG_31);
+        const uint16_t r31 = readRegister(BK4819_REG_31);
 
         if (mode == 0) {    // disable
-            spi.writeRegister(BK4819_REG_31, static_cast<uint16_t>(r31 & ~(1u << 3)));
+            writeRegister(BK4819_REG_31, static_cast<uint16_t>(r31 & ~(1u << 3)));
             return;
         }
 
@@ -594,7 +742,7 @@ public:
         const uint16_t compress_0dB = 86;
         const uint16_t compress_noise_dB = 64;
         //	AB40  10 1010110 1000000
-        spi.writeRegister(BK4819_REG_29, // (BK4819_ReadRegister(BK4819_REG_29) & ~(3u << 14)) | (compress_ratio << 14));
+        writeRegister(BK4819_REG_29, // (BK4819_ReadRegister(BK4819_REG_29) & ~(3u << 14)) | (compress_ratio << 14));
             (compress_ratio << 14) |
             (compress_0dB << 7) |
             (compress_noise_dB << 0));
@@ -615,18 +763,18 @@ public:
         const uint16_t expand_0dB = 86;
         const uint16_t expand_noise_dB = 56;
         //	6B38  01 1010110 0111000
-        spi.writeRegister(BK4819_REG_28, // (BK4819_ReadRegister(BK4819_REG_28) & ~(3u << 14)) | (expand_ratio << 14));
+        writeRegister(BK4819_REG_28, // (BK4819_ReadRegister(BK4819_REG_28) & ~(3u << 14)) | (expand_ratio << 14));
             (expand_ratio << 14) |
             (expand_0dB << 7) |
             (expand_noise_dB << 0));
 
         // enable
-        spi.writeRegister(BK4819_REG_31, r31 | (1u << 3));
+        writeRegister(BK4819_REG_31, r31 | (1u << 3));
     }
 
     void setSleepMode(void) {
-        spi.writeRegister(BK4819_REG_30, 0x0000);
-        spi.writeRegister(BK4819_REG_37, 0x1D00);
+        writeRegister(BK4819_REG_30, 0x0000);
+        writeRegister(BK4819_REG_37, 0x1D00);
         toggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, false);
     }
 
@@ -662,18 +810,18 @@ public:
         //                                  280MHz       g1=1  g2=0 (-14.9dBm),  g1=4  g2=2 (0.13dBm)
         const uint8_t gain   = (frequency < 28000000) ? (1u << 3) | (0u << 0) : (4u << 3) | (2u << 0);
         const uint8_t enable = 1;
-        spi.writeRegister(BK4819_REG_36, (bias << 8) | (enable << 7) | (gain << 0));
+        writeRegister(BK4819_REG_36, (bias << 8) | (enable << 7) | (gain << 0));
     }
 
     void enableTone1(uint8_t gain) {
-        spi.writeRegister(
+        writeRegister(
             BK4819_REG_70,
             BK4819_REG_70_ENABLE_TONE1 |
             (static_cast<uint16_t>(gain) << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
     }
 
     void disableTones(void) {
-        spi.writeRegister(BK4819_REG_70, 0);
+        writeRegister(BK4819_REG_70, 0);
     }
 
 
@@ -712,7 +860,25 @@ private:
     static constexpr uint32_t VHF_UHF_BOUND1 = 24000000;
     static constexpr uint32_t VHF_UHF_BOUND2 = 28000000;
 
+    static constexpr uint8_t REGISTER_COUNT = 0x80;
+
+    static constexpr uint16_t REG_37_RX_ON = 0x1F0F;
+    static constexpr uint16_t REG_30_RX_ON =
+        BK4819_REG_30_ENABLE_VCO_CALIB | BK4819_REG_30_DISABLE_UNKNOWN |
+        BK4819_REG_30_ENABLE_RX_LINK | BK4819_REG_30_ENABLE_AF_DAC |
+        BK4819_REG_30_ENABLE_DISC_MODE | BK4819_REG_30_ENABLE_PLL_VCO |
+        BK4819_REG_30_DISABLE_PA_GAIN | BK4819_REG_30_DISABLE_MIC_ADC |
+        BK4819_REG_30_DISABLE_TX_DSP | BK4819_REG_30_ENABLE_RX_DSP;
+
     SPISoftwareInterface spi;
+    uint16_t shadowRegs[REGISTER_COUNT] = {};
+    uint32_t shadowValid[REGISTER_COUNT / 32] = {};
+    RegisterProfile* profile = nullptr;
+    bool applyingProfile = false;
+    uint8_t profileEpoch = 0;
+    uint32_t profiledRegs[REGISTER_COUNT / 32] = {};    // held by a profile of this epoch
+    uint16_t baselineRegs[REGISTER_COUNT] = {};         // the shadow after setupRegisters()
+    uint32_t baselineValid[REGISTER_COUNT / 32] = {};
     uint16_t gpioOutState;
     bool txActive = false;
     uint32_t lastTxFrequency = 0;
@@ -764,9 +930,119 @@ private:
     // Method to perform a soft reset
     void softReset() {
         // Set REG_00<15> to 1 for soft reset
-        spi.writeRegister(BK4819_REG_00, 0x8000);
+        writeRegister(BK4819_REG_00, 0x8000);
         // Set back to normal mode
-        spi.writeRegister(BK4819_REG_00, 0x0000);
+        writeRegister(BK4819_REG_00, 0x0000);
+        invalidateRegisters();
+    }
+
+    // Read-only or changed by the chip itself: never cached
+    static constexpr bool isStatusRegister(uint8_t reg) {
+        switch (reg) {
+        case BK4819_REG_02: // interrupt flags
+        case BK4819_REG_0B: // DTMF / tone results
+        case BK4819_REG_0C: // interrupt request, squelch
+        case BK4819_REG_0D: // frequency scan
+        case BK4819_REG_0E:
+        case BK4819_REG_3F: // interrupt mask, shared with the IRQ handling
+        case BK4819_REG_5F: // FSK FIFO
+        case BK4819_REG_61: // SNR, glitch, amplitude, noise, RSSI
+        case BK4819_REG_63:
+        case BK4819_REG_64:
+        case BK4819_REG_65:
+        case BK4819_REG_67:
+        case BK4819_REG_68: // CTCSS / CDCSS scan results
+        case BK4819_REG_69:
+        case BK4819_REG_6A:
+        case BK4819_REG_6F:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Writing these starts something on the chip, even with the same value
+    static constexpr bool isCommandRegister(uint8_t reg) {
+        return reg == BK4819_REG_00 ||  // soft reset
+            reg == BK4819_REG_07 ||     // CTC1 / CTC2 / CDCSS words share it
+            reg == BK4819_REG_08 ||     // CDCSS code word halves
+            reg == BK4819_REG_30 ||     // power up sequence, VCO calibration
+            reg == BK4819_REG_59;       // FSK FIFO clear, TX / RX enable
+    }
+
+    bool shadowHas(uint8_t reg) const {
+        return shadowValid[reg >> 5] & (1UL << (reg & 31U));
+    }
+
+    void shadowStore(uint8_t reg, uint16_t value) {
+        shadowRegs[reg] = value;
+        shadowValid[reg >> 5] |= 1UL << (reg & 31U);
+    }
+
+    // Latest write to reg in the profile being recorded, -1 if none
+    int8_t profileFind(uint8_t reg) const {
+        for (int8_t i = (int8_t)profile->count - 1; i >= 0; i--) {
+            if (profile->regs[i] == reg) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void profileStore(uint8_t reg, uint16_t value) {
+        // Command registers keep every write, in order; the others only need
+        // their final value
+        int8_t i = isCommandRegister(reg) ? -1 : profileFind(reg);
+        if (i >= 0) {
+            profile->values[i] = value;
+        }
+        else if (profile->count < RegisterProfile::MAX_WRITES) {
+            profile->regs[profile->count] = reg;
+            profile->values[profile->count++] = value;
+            profiledRegs[reg >> 5] |= 1UL << (reg & 31U);
+        }
+        else {
+            profile->valid = false;
+        }
+    }
+
+    uint16_t readRegister(uint8_t reg) {
+        if (profile) {
+            int8_t i = profileFind(reg);
+            if (i >= 0) {
+                return profile->values[i];
+            }
+            if (baselineValid[reg >> 5] & (1UL << (reg & 31U))) {
+                return baselineRegs[reg];
+            }
+        }
+        if (shadowHas(reg)) {
+            return shadowRegs[reg];
+        }
+        return resyncRegister(reg);
+    }
+
+    void writeRegister(uint8_t reg, uint16_t value) {
+        if (profile) {
+            profileStore(reg, value);
+            return;
+        }
+        if (isStatusRegister(reg)) {
+            spi.writeRegister(reg, value);
+            return;
+        }
+        if (shadowHas(reg) && shadowRegs[reg] == value && !isCommandRegister(reg)) {
+            return;
+        }
+        if (!applyingProfile && (profiledRegs[reg >> 5] & (1UL << (reg & 31U)))) {
+            // Every profile of this epoch would now replay a stale value
+            profileEpoch++;
+            for (uint32_t& regs : profiledRegs) {
+                regs = 0;
+            }
+        }
+        spi.writeRegister(reg, value);
+        shadowStore(reg, value);
     }
 
     // Method to toggle a GPIO output
@@ -777,12 +1053,12 @@ private:
         else
             gpioOutState &= (uint16_t)~(0x40u >> pin);
 
-        spi.writeRegister(BK4819_REG_33, gpioOutState);
+        writeRegister(BK4819_REG_33, gpioOutState);
     }
 
     void setFrequency(uint32_t frequency) {
-        spi.writeRegister(BK4819_REG_38, frequency & 0xFFFF);
-        spi.writeRegister(BK4819_REG_39, static_cast<uint16_t>((frequency >> 16) & 0xFFFF));
+        writeRegister(BK4819_REG_38, frequency & 0xFFFF);
+        writeRegister(BK4819_REG_39, static_cast<uint16_t>((frequency >> 16) & 0xFFFF));
     }
 
     void selectFilter(uint32_t frequency) {
@@ -807,25 +1083,25 @@ private:
     void setupSquelch(uint8_t ro, uint8_t rc, uint8_t no, uint8_t nc,
         uint8_t gc, uint8_t go, uint8_t delayO,
         uint8_t delayC) {
-        spi.writeRegister(BK4819_REG_4D, 0xA000 | gc);
-        spi.writeRegister(
+        writeRegister(BK4819_REG_4D, 0xA000 | gc);
+        writeRegister(
             BK4819_REG_4E,
             (1u << 14) |                   //  1 ???
             static_cast<uint16_t>(delayO << 11) | // *5  squelch = open  delay .. 0 ~ 7
             static_cast<uint16_t>(delayC << 9) |  // *3  squelch = close delay .. 0 ~ 3
             go);
-        spi.writeRegister(BK4819_REG_4F, (nc << 8) | no);
-        spi.writeRegister(BK4819_REG_78, (ro << 8) | rc);
+        writeRegister(BK4819_REG_4F, (nc << 8) | no);
+        writeRegister(BK4819_REG_78, (ro << 8) | rc);
     }
 
     uint16_t getRegValue(RegisterSpec s) {
-        return (spi.readRegister(s.num) >> s.offset) & s.mask;
+        return (readRegister(s.num) >> s.offset) & s.mask;
     }
 
     void setRegValue(RegisterSpec s, uint16_t v) {
-        uint16_t reg = spi.readRegister(s.num);
+        uint16_t reg = readRegister(s.num);
         reg &= (uint16_t)~(s.mask << s.offset);
-        spi.writeRegister(s.num, reg | (v << s.offset));
+        writeRegister(s.num, reg | (v << s.offset));
     }
 
     uint16_t scaleFreq(const uint16_t freq) {
@@ -2,10 +2,27 @@
 
 #include <cstdint>
 #include <cstring>
+#include "ARMCM0.h"
 #include "i2c_hal.h"
+#include "misc.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 
+// 24C64 behind the bit-banged I2C bus.
+//
+// Writes are staged per 32-byte page: writes to a page that is still
+// waiting merge into it, and each staged page is programmed once, only the
+// bytes that differ from the part. Once startTask() ran, a task at idle
+// priority programs them and writeBuffer() only copies the data, waiting
+// for a free slot when all of them hold pages; before that (boot, host
+// benches) writeBuffer() programs them itself. Reads always see the staged
+// data.
+//
+// The bus lines double as keypad rows, so every I2C transfer runs with
+// interrupts off: the read-back in short reads, then the page write. The
+// compare and the part's internal write cycle pass with them on, the next
+// bus access polls the part first.
 class EEPROM {
 public:
     EEPROM() {};
@@ -15,6 +32,32 @@ public:
     static constexpr uint8_t BASE_ADDRESS = 0xA0;
     static constexpr uint32_t PROTECTED_ADDR = 0x1E00;
     static constexpr uint32_t PROTECTED_SIZE = 0x200;
+    static constexpr uint8_t STAGED_PAGES = 8;
+
+    // Page program times, from the end of the page write to the ACK that
+    // ends the polling, on the SysTick clock. For diagnostics.
+    struct WriteStats {
+        uint32_t pages;         // page writes completed
+        uint16_t errors;        // page writes NACKed or never acknowledged
+        uint16_t lastUs;        // write cycle of the last page
+        uint16_t maxUs;         // longest write cycle so far
+    };
+
+    void startTask(void) {
+        if (writerTask) {
+            return;
+        }
+        slotFree = xSemaphoreCreateBinaryStatic(&slotFreeBuffer);
+        writerTask = xTaskCreateStatic(
+            EEPROM::runWriterTask,
+            "EEPROM",
+            ARRAY_SIZE(writerTaskStack),
+            this,
+            tskIDLE_PRIORITY,
+            writerTaskStack,
+            &writerTaskBuffer
+        );
+    }
 
     // Core EEPROM operations
     void readBuffer(uint32_t address, void* buffer, uint16_t size) {
@@ -22,26 +65,22 @@ public:
             return;
         }
 
-        taskENTER_CRITICAL();
-
-        uint8_t deviceAddr = getDeviceAddress(address);
-
-        i2c.start();
-        i2c.write(deviceAddr);
-        i2c.write(static_cast<uint8_t>((address >> 8) & 0xFF));
-        i2c.write(static_cast<uint8_t>(address & 0xFF));
-
-        i2c.start();
-        i2c.write(deviceAddr | 0x01);  // Set read bit
-        i2c.readBuffer(static_cast<uint8_t*>(buffer), size);
-        i2c.stop();
+        settle();
 
+        taskENTER_CRITICAL();
+        waitReady();
+        readRaw(address, static_cast<uint8_t*>(buffer), size);
+        overlayStaged(address, static_cast<uint8_t*>(buffer), size);
         taskEXIT_CRITICAL();
     }
 
-    void writeBuffer(uint32_t address, const void* buffer, uint16_t size) {
+    // Stages the data; false when the range is protected or, without the
+    // writer task, a page write failed. With the writer task the pages are
+    // programmed after this returns: a failure counts in getWriteStats()
+    // and makes the next flush() return false.
+    bool writeBuffer(uint32_t address, const void* buffer, uint16_t size) {
         if (!buffer || size == 0) {
-            return;
+            return false;
         }
 
         // Calculate write end address
@@ -50,12 +89,11 @@ public:
         if ((address >= PROTECTED_ADDR && address < (PROTECTED_ADDR + PROTECTED_SIZE)) ||
             (endAddr >= PROTECTED_ADDR && endAddr < (PROTECTED_ADDR + PROTECTED_SIZE)) ||
             (address < PROTECTED_ADDR && endAddr >= (PROTECTED_ADDR + PROTECTED_SIZE))) {
-            return;  // Protected area
+            return false;  // Protected area
         }
 
         const uint8_t* data = static_cast<const uint8_t*>(buffer);
-
-        taskENTER_CRITICAL();
+        bool ok = true;
 
         while (size > 0) {
             // Calculate page boundaries
@@ -63,23 +101,15 @@ public:
             uint16_t remainingInPage = PAGE_SIZE - offset;
             uint16_t writeSize = (size < remainingInPage) ? size : remainingInPage;
 
-            // Read current content
-            readBuffer(address, tmpBuffer, writeSize);
-
-            // Only write if data is different
-            if (memcmp(data, tmpBuffer, writeSize) != 0) {
-                uint8_t deviceAddr = getDeviceAddress(address);
-
-                i2c.start();
-                i2c.write(deviceAddr);
-                i2c.write(static_cast<uint8_t>((address >> 8) & 0xFF));
-                i2c.write(static_cast<uint8_t>(address & 0xFF));
-
-                i2c.writeBuffer(data, writeSize);
-                i2c.stop();
-
-                // Wait for write to complete
-                waitForWrite();
+            // Every slot holds another page: wait for the writer task to
+            // program one, or program one here without it
+            while (!stage(address, data, writeSize)) {
+                if (writerTask) {
+                    waitSlotFree();
+                }
+                else {
+                    ok = programStaged() && ok;
+                }
             }
 
             // Update pointers and remaining size
@@ -88,10 +118,71 @@ public:
             size -= writeSize;
         }
 
+        if (writerTask) {
+            xTaskNotifyGive(writerTask);
+            return ok;
+        }
+        return flush() && ok;
+    }
+
+    // Returns once every staged page is on the part, false if a page
+    // write failed since the last flush. For reset and power off, and for
+    // callers that need to know their writes made it.
+    bool flush(void) {
+        while (hasStaged() || inFlight.mask) {
+            if (writerTask) {
+                waitSlotFree();
+            }
+            else {
+                programStaged();
+            }
+        }
+        settle();
+
+        taskENTER_CRITICAL();
+        bool ok = !writeFailed;
+        writeFailed = false;
         taskEXIT_CRITICAL();
+        return ok;
+    }
+
+    const WriteStats& getWriteStats() const {
+        return writeStats;
     }
 
 private:
+    // tWR is 5 ms max on the 24C64, give it twice that
+    static constexpr uint32_t WRITE_TIMEOUT_US = 10000;
+    static constexpr uint32_t CYCLES_PER_US = configCPU_CLOCK_HZ / 1000000U;
+    static constexpr uint32_t CYCLES_PER_TICK = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    // Read-back transfer length, about 0.3 ms with interrupts off
+    static constexpr uint8_t READ_BACK_CHUNK = 8;
+
+    // A page waiting to be programmed, mask has a bit per byte written
+    struct StagedPage {
+        uint16_t address;
+        uint32_t mask;
+        uint8_t data[PAGE_SIZE];
+    };
+
+    static void runWriterTask(void* pvParameters) {
+        EEPROM* eeprom = static_cast<EEPROM*>(pvParameters);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            while (eeprom->hasStaged()) {
+                eeprom->programStaged();
+                xSemaphoreGive(eeprom->slotFree);
+            }
+        }
+    }
+
+    // Blocks the caller until the writer task has programmed a page. A
+    // give left over from earlier only costs another pass of the caller's
+    // loop.
+    void waitSlotFree(void) {
+        xTaskNotifyGive(writerTask);
+        xSemaphoreTake(slotFree, portMAX_DELAY);
+    }
 
     // Internal helper methods
     uint8_t getDeviceAddress(__attribute__((unused)) uint32_t address) const {
@@ -99,14 +190,247 @@ private:
         return static_cast<uint8_t>(BASE_ADDRESS);
     }
 
-    void waitForWrite() const {
-        delayMs(2);  // Wait for EEPROM write to complete
+    void readRaw(uint32_t address, uint8_t* buffer, uint16_t size) {
+        uint8_t deviceAddr = getDeviceAddress(address);
+
+        i2c.start();
+        i2c.write(deviceAddr);
+        i2c.write(static_cast<uint8_t>((address >> 8) & 0xFF));
+        i2c.write(static_cast<uint8_t>(address & 0xFF));
+
+        i2c.start();
+        i2c.write(deviceAddr | 0x01);  // Set read bit
+        i2c.readBuffer(buffer, size);
+        i2c.stop();
+    }
+
+    bool stage(uint32_t address, const uint8_t* data, uint16_t size) {
+        uint16_t pageAddress = static_cast<uint16_t>(address & ~(PAGE_SIZE - 1U));
+        uint8_t offset = static_cast<uint8_t>(address % PAGE_SIZE);
+        uint32_t bits = size >= PAGE_SIZE ? UINT32_MAX : (1U << size) - 1U;
+
+        taskENTER_CRITICAL();
+        StagedPage* slot = nullptr;
+        for (StagedPage& page : staged) {
+            if (page.mask && page.address == pageAddress) {
+                slot = &page;
+                break;
+            }
+            if (!page.mask && !slot) {
+                slot = &page;
+            }
+        }
+        if (slot) {
+            if (!slot->mask) {
+                slot->address = pageAddress;
+            }
+            memcpy(&slot->data[offset], data, size);
+            slot->mask |= bits << offset;
+        }
+        taskEXIT_CRITICAL();
+        return slot != nullptr;
+    }
+
+    bool hasStaged(void) const {
+        for (const StagedPage& page : staged) {
+            if (page.mask) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The page being programmed first, staged pages are newer
+    void overlayStaged(uint32_t address, uint8_t* buffer, uint16_t size) const {
+        overlayPage(inFlight, address, buffer, size);
+        for (const StagedPage& page : staged) {
+            overlayPage(page, address, buffer, size);
+        }
+    }
+
+    static void overlayPage(const StagedPage& page, uint32_t address, uint8_t* buffer, uint16_t size) {
+        for (uint8_t i = 0; page.mask && i < PAGE_SIZE; i++) {
+            uint32_t at = page.address + i;
+            if ((page.mask & (1U << i)) && at >= address && at < address + size) {
+                buffer[at - address] = page.data[i];
+            }
+        }
+    }
+
+    // Programs one staged page, if any. The staged span is read back first
+    // so the write covers only the bytes that changed, in one page cycle.
+    // The page moves to inFlight while this runs, where reads still see it.
+    // Only one caller at a time: the writer task, or the caller of
+    // writeBuffer()/flush() while there is none.
+    bool programStaged(void) {
+        settle();
+
+        taskENTER_CRITICAL();
+        for (StagedPage& candidate : staged) {
+            if (candidate.mask) {
+                inFlight = candidate;
+                candidate.mask = 0;
+                break;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (!inFlight.mask) {
+            return true;
+        }
+
+        uint8_t low = static_cast<uint8_t>(__builtin_ctz(inFlight.mask));
+        uint8_t high = static_cast<uint8_t>(31 - __builtin_clz(inFlight.mask));
+        for (uint8_t at = low; at <= high; at = static_cast<uint8_t>(at + READ_BACK_CHUNK)) {
+            uint8_t length = static_cast<uint8_t>(high - at + 1);
+            length = length < READ_BACK_CHUNK ? length : READ_BACK_CHUNK;
+            taskENTER_CRITICAL();
+            waitReady();
+            readRaw(inFlight.address + at, &tmpBuffer[at], length);
+            taskEXIT_CRITICAL();
+        }
+
+        uint8_t first = PAGE_SIZE;
+        uint8_t last = 0;
+        for (uint8_t i = 0; i < PAGE_SIZE; i++) {
+            if ((inFlight.mask & (1U << i)) && tmpBuffer[i] != inFlight.data[i]) {
+                tmpBuffer[i] = inFlight.data[i];
+                first = first < i ? first : i;
+                last = i;
+            }
+        }
+
+        bool ok = true;
+
+        taskENTER_CRITICAL();
+        // Only write if data is different
+        if (first <= last) {
+            uint32_t address = inFlight.address + first;
+            uint8_t deviceAddr = getDeviceAddress(address);
+
+            waitReady();
+            i2c.start();
+            ok = i2c.write(deviceAddr) == 0 &&
+                i2c.write(static_cast<uint8_t>((address >> 8) & 0xFF)) == 0 &&
+                i2c.write(static_cast<uint8_t>(address & 0xFF)) == 0 &&
+                i2c.writeBuffer(&tmpBuffer[first], static_cast<uint16_t>(last - first + 1)) == 0;
+            i2c.stop();
+
+            if (ok) {
+                // The write cycle runs from here, see settle(); reads wait
+                // for it, so the page can leave inFlight
+                busy = true;
+                writeAddress = deviceAddr;
+                startWriteClock();
+            }
+            else {
+                writeStats.errors++;
+                writeFailed = true;
+            }
+        }
+        inFlight.mask = 0;
+        taskEXIT_CRITICAL();
+        return ok;
+    }
+
+    // The part does not answer its address while it programs the page:
+    // re-address it until it ACKs instead of sleeping for the worst case.
+    // True once it is done (or gave up).
+    bool pollReady(void) {
+        if (!busy) {
+            return true;
+        }
+        i2c.start();
+        bool ready = i2c.write(writeAddress) == 0;
+        uint32_t us = writeClockCycles() / CYCLES_PER_US;
+        if (ready || us >= WRITE_TIMEOUT_US) {
+            i2c.stop();
+            busy = false;
+            if (ready) {
+                writeStats.pages++;
+                writeStats.lastUs = static_cast<uint16_t>(us);
+                if (writeStats.lastUs > writeStats.maxUs) {
+                    writeStats.maxUs = writeStats.lastUs;
+                }
+            }
+            else {
+                writeStats.errors++;
+                writeFailed = true;
+            }
+        }
+        return !busy;
+    }
+
+    // The write cycle is timed on SysTick, which counts down at the CPU
+    // clock and wraps every tick. The samples the polls take count the
+    // wraps; when a poll was preempted for longer than a tick the tick count
+    // gives a lower bound instead, less one tick that may have been pending
+    // when the clock started inside the critical section.
+    void startWriteClock(void) {
+        clockStartValue = SysTick->VAL;
+        clockLastValue = clockStartValue;
+        clockStartTick = xTaskGetTickCount();
+        clockWraps = 0;
+    }
+
+    uint32_t writeClockCycles(void) {
+        TickType_t ticks = xTaskGetTickCount() - clockStartTick;
+        uint32_t value = SysTick->VAL;
+        if (value > clockLastValue) {
+            clockWraps++;
+        }
+        clockLastValue = value;
+
+        uint32_t cycles = clockWraps * (SysTick->LOAD + 1U) + clockStartValue - value;
+        if (ticks > 2 && (ticks - 2) * CYCLES_PER_TICK > cycles) {
+            cycles = (ticks - 2) * CYCLES_PER_TICK;
+        }
+        return cycles;
+    }
+
+    // Waits out a write cycle with interrupts on between the polls
+    void settle(void) {
+        bool ready = false;
+        while (!ready) {
+            taskENTER_CRITICAL();
+            ready = pollReady();
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    // Same, inside a critical section that must not be left
+    void waitReady(void) {
+        while (!pollReady()) {
+        }
     }
 
     // Reference to I2C instance
     I2C i2c;
 
-    // Temporary buffer for write operations
-    static constexpr size_t TMP_BUFFER_SIZE = 128;
-    uint8_t tmpBuffer[TMP_BUFFER_SIZE];
-};
\ No newline at end of file
+    // Page read back for the compare
+    uint8_t tmpBuffer[PAGE_SIZE];
+
+    StagedPage staged[STAGED_PAGES] = {};
+    StagedPage inFlight = {};
+
+    // A page write failed since the last flush()
+    bool writeFailed = false;
+
+    // A write cycle is running, polled with the device address it was for
+    bool busy = false;
+    uint8_t writeAddress = BASE_ADDRESS;
+
+    // Write cycle clock, see startWriteClock()
+    uint32_t clockStartValue = 0;
+    uint32_t clockLastValue = 0;
+    uint32_t clockWraps = 0;
+    TickType_t clockStartTick = 0;
+
+    WriteStats writeStats = {};
+
+    TaskHandle_t writerTask = nullptr;
+    StaticTask_t writerTaskBuffer;
+    StackType_t writerTaskStack[configMINIMAL_STACK_SIZE];
+    SemaphoreHandle_t slotFree = nullptr;
+    StaticSemaphore_t slotFreeBuffer;
+};
@@ -57,6 +57,7 @@ enum GPIOB_PINS {
 	GPIOB_PIN_BK1080     = 15
 };
 
+// Outputs only driven from the radio task, see SPISoftwareInterface::select()
 enum GPIOC_PINS {
 	GPIOC_PIN_BK4819_SCN = 0,
 	GPIOC_PIN_BK4819_SCL = 1,
@@ -83,3 +84,18 @@ static inline void GPIO_SetBit(volatile uint32_t *pReg, uint8_t Bit) {
 	*pReg |= 1U << Bit;
 }
 
+// Whole port in one store. Bit-banged buses compose the DATA word once per
+// edge instead of a load / modify / store per pin.
+static inline void GPIO_Write(volatile uint32_t *pReg, uint32_t Value) {
+	*pReg = Value;
+}
+
+// Pads a bus edge by a number of core cycles. Called with constants, the
+// loop unrolls into that many NOPs.
+static inline __attribute__((always_inline)) void GPIO_Wait(const uint32_t Cycles) {
+#pragma GCC unroll 32
+	for (uint32_t i = 0; i < Cycles; i++) {
+		__asm volatile ("nop");
+	}
+}
+
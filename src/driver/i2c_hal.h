@@ -1,127 +1,124 @@
 #pragma once
 
 #include <cstdint>
+#include <utility>
 
 #include "sys.h"
 #include "gpio.h"
 #include "portcon.h"
 #include "gpio_hal.h"
 
+// 24C64 fast-mode (400 kHz) timing, turned into core cycles at compile time
+// the same way as BK4819SPITiming. The part wants tLOW 1.3 us and tHIGH
+// 0.6 us; the low phase also carries the open drain SDA rise (300 ns max)
+// and the data out time tAA (0.9 us), the pair is stretched to the 2.5 us
+// period.
+struct I2CTiming {
+    static constexpr uint32_t CPU_MHZ = 48;
+    static constexpr uint32_t STORE_CYCLES = 2;     // STR to GPIOA
+
+    static constexpr uint32_t SCL_LOW_NS = 1500;
+    static constexpr uint32_t SCL_HIGH_NS = 1000;
+    static constexpr uint32_t START_SETUP_NS = 600; // SCL high to SDA low (repeated START)
+    static constexpr uint32_t START_HOLD_NS = 600;  // SDA low to the first SCL fall
+    static constexpr uint32_t STOP_SETUP_NS = 600;  // SCL high to SDA high
+    static constexpr uint32_t BUS_FREE_NS = 1300;   // STOP to the next START
+
+    static_assert(SCL_LOW_NS + SCL_HIGH_NS >= 2500, "SCL above 400 kHz");
+
+    // Cycles to wait after a store for ns to have passed
+    static constexpr uint32_t pad(uint32_t ns) {
+        uint32_t cycles = (ns * CPU_MHZ + 999) / 1000;
+        return cycles > STORE_CYCLES ? cycles - STORE_CYCLES : 0;
+    }
+};
+
+// Bit-banged I2C master on GPIOA 10 (SCL) / 11 (SDA). Every edge is a whole
+// port store; the other GPIOA pins (the keypad rows) keep the state read at
+// the start of each call, callers hold a critical section around a
+// transfer so the keypad scan can't move them underneath.
 class I2C {
 public:
     // Constants
     static constexpr uint8_t WRITE = 0U;
     static constexpr uint8_t READ = 1U;
-    
+
     I2C() {};
 
-    // Core I2C operations
+    // Core I2C operations, START and repeated START
     void start() {
-        setSDA(true);
-        delayMicroseconds(1);
-        setSCL(true);
-        delayMicroseconds(1);
-        setSDA(false);
-        delayMicroseconds(1);
-        setSCL(false);
-        delayMicroseconds(1);
+        uint32_t port = idle();
+        GPIO_Write(&GPIOA->DATA, port | SDA);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOA->DATA, port | SDA | SCL);
+        GPIO_Wait(Timing::pad(Timing::START_SETUP_NS));
+        GPIO_Write(&GPIOA->DATA, port | SCL);
+        GPIO_Wait(Timing::pad(Timing::START_HOLD_NS));
+        GPIO_Write(&GPIOA->DATA, port);
     }
+
     void stop() {
-        setSDA(false);
-        delayMicroseconds(1);
-        setSCL(false);
-        delayMicroseconds(1);
-        setSCL(true);
-        delayMicroseconds(1);
-        setSDA(true);
-        delayMicroseconds(1);
+        uint32_t port = idle();
+        GPIO_Write(&GPIOA->DATA, port);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOA->DATA, port | SCL);
+        GPIO_Wait(Timing::pad(Timing::STOP_SETUP_NS));
+        GPIO_Write(&GPIOA->DATA, port | SCL | SDA);
+        GPIO_Wait(Timing::pad(Timing::BUS_FREE_NS));
     }
 
-    // Reading operations
-    uint8_t read(bool isFinal) {
-        uint8_t data = 0;
+    // Reading operations, the bit loops run from RAM. isFinal NACKs the
+    // byte, which ends a sequential read.
+    RAMFUNC uint8_t read(bool isFinal) {
+        uint32_t port = idle();
 
         configureSDAPinInput();
-
-        for (int i = 0; i < 8; i++) {
-            setSCL(false);
-            delayMicroseconds(1);
-            setSCL(true);
-            delayMicroseconds(1);
-            data <<= 1;
-            delayMicroseconds(1);
-            if (readSDA()) {
-                data |= 1U;
-            }
-            setSCL(false);
-            delayMicroseconds(1);
-        }
-
+        uint8_t data = (uint8_t)shiftIn(port, std::make_index_sequence<8>{});
         configureSDAPinOutput();
-        setSCL(false);
-        delayMicroseconds(1);
-        setSDA(isFinal);
-        delayMicroseconds(1);
-        setSCL(true);
-        delayMicroseconds(1);
-        setSCL(false);
-        delayMicroseconds(1);
+
+        // ACK keeps the part sending, SCL is low again on return
+        uint32_t ack = isFinal ? SDA : 0;
+        GPIO_Write(&GPIOA->DATA, port | ack);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOA->DATA, port | ack | SCL);
+        GPIO_Wait(Timing::pad(Timing::SCL_HIGH_NS));
+        GPIO_Write(&GPIOA->DATA, port | ack);
+        GPIO_Write(&GPIOA->DATA, port | SDA);
 
         return data;
     }
 
+    // A sequential read of any length after one address phase, the part
+    // moves to the next address on every ACK
     uint16_t readBuffer(uint8_t* buffer, uint16_t size) {
         if (!buffer || size == 0) {
             return 0;
         }
 
-        for (uint16_t i = 0; i < size - 1; i++) {
-            delayMicroseconds(1);
-            buffer[i] = read(false);
+        for (uint16_t i = 0; i < size; i++) {
+            buffer[i] = read(i == size - 1);
         }
 
-        delayMicroseconds(1);
-        buffer[size - 1] = read(true);
-
         return size;
     }
 
-    // Writing operations
-    int16_t write(uint8_t data) {
-        int16_t ret = -1;
-
-        setSCL(false);
-        delayMicroseconds(1);
-
-        for (int i = 0; i < 8; i++) {
-            setSDA((data & 0x80) != 0);
-            data <<= 1;
-            delayMicroseconds(1);
-            setSCL(true);
-            delayMicroseconds(1);
-            setSCL(false);
-            delayMicroseconds(1);
-        }
+    // Writing operations, -1 when the part does not ACK the byte
+    RAMFUNC int16_t write(uint8_t data) {
+        uint32_t port = idle();
 
-        configureSDAPinInput();
-        setSDA(true);
-        delayMicroseconds(1);
-        setSCL(true);
-        delayMicroseconds(1);
-
-        for (int i = 0; i < 255; i++) {
-            if (!readSDA()) {
-                ret = 0;
-                break;
-            }
-        }
+        shiftOut(data, port, std::make_index_sequence<8>{});
 
-        setSCL(false);
-        delayMicroseconds(1);
+        // Release SDA and clock the ACK in, sampled once SCL has been high
+        configureSDAPinInput();
+        GPIO_Write(&GPIOA->DATA, port | SDA);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOA->DATA, port | SDA | SCL);
+        GPIO_Wait(Timing::pad(Timing::SCL_HIGH_NS));
+        bool nack = readSDA();
+        GPIO_Write(&GPIOA->DATA, port | SDA);
         configureSDAPinOutput();
-        setSDA(true);
 
-        return ret;
+        return nack ? -1 : 0;
     }
 
     int16_t writeBuffer(const uint8_t* buffer, uint16_t size) {
@@ -138,7 +135,52 @@ public:
     }
 
 
-private:    
+private:
+    using Timing = I2CTiming;
+
+    static constexpr uint32_t SCL = 1U << GPIOA_PIN_I2C_SCL;
+    static constexpr uint32_t SDA = 1U << GPIOA_PIN_I2C_SDA;
+
+    // GPIOA with both bus pins low
+    static uint32_t idle(void) {
+        return GPIOA->DATA & ~(SCL | SDA);
+    }
+
+    // One bit, MSB first: SDA moves with SCL low, then a clock pulse. SCL is
+    // brought low before SDA changes again, a change while it is high would
+    // be a START or STOP.
+    template <uint8_t Bit>
+    static inline __attribute__((always_inline)) void writeBit(uint8_t data, uint32_t port) {
+        uint32_t sda = (data & (1U << Bit)) ? SDA : 0;
+        GPIO_Write(&GPIOA->DATA, port | sda);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOA->DATA, port | sda | SCL);
+        GPIO_Wait(Timing::pad(Timing::SCL_HIGH_NS));
+        GPIO_Write(&GPIOA->DATA, port | sda);
+    }
+
+    // The part puts the bit out after SCL falls, it is read at the end of
+    // the high phase
+    static inline __attribute__((always_inline)) uint32_t readBit(uint32_t port) {
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOA->DATA, port | SDA | SCL);
+        GPIO_Wait(Timing::pad(Timing::SCL_HIGH_NS));
+        uint32_t bit = GPIO_CheckBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
+        GPIO_Write(&GPIOA->DATA, port | SDA);
+        return bit;
+    }
+
+    template <size_t... I>
+    static inline __attribute__((always_inline)) void shiftOut(uint8_t data, uint32_t port, std::index_sequence<I...>) {
+        (writeBit<sizeof...(I) - 1 - I>(data, port), ...);
+    }
+
+    template <size_t... I>
+    static inline __attribute__((always_inline)) uint32_t shiftIn(uint32_t port, std::index_sequence<I...>) {
+        uint32_t value = 0;
+        ((value = (value << 1) | readBit(port), (void)I), ...);
+        return value;
+    }
 
     void configureSDAPinInput() {
         PORTCON_PORTA_IE |= PORTCON_PORTA_IE_A11_BITS_ENABLE;
@@ -152,29 +194,7 @@ private:
         GPIOA->DIR |= GPIO_DIR_11_BITS_OUTPUT;
     }
 
-    void setSCL(bool state) {
-        if (state) {
-            GPIO_SetBit(&GPIOA->DATA, GPIOA_PIN_I2C_SCL);
-        }
-        else {
-            GPIO_ClearBit(&GPIOA->DATA, GPIOA_PIN_I2C_SCL);
-        }
-    }
-
-    void setSDA(bool state) {
-        if (state) {
-            GPIO_SetBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
-        }
-        else {
-            GPIO_ClearBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
-        }
-    }
-
     bool readSDA() {
         return GPIO_CheckBit(&GPIOA->DATA, GPIOA_PIN_I2C_SDA);
     }
-
-    void delayMicroseconds(uint32_t us) {
-        delayUs(us);
-    }
-};
\ No newline at end of file
+};
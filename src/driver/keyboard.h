@@ -54,6 +54,9 @@ public:
 
     void clearFKeyPressed() { mWasFKeyPressed = false; }
 
+    // A key or PTT is down
+    bool isKeyHeld() const { return mPrevKeyState != KeyState::KEY_RELEASED || mKeyPtt; }
+
 private:
 
     System::SystemTask& systask;
@@ -1,11 +1,32 @@
 #pragma once
 
 #include <cstdint>
+#include <utility>
 #include "sys.h"
 #include "gpio.h"
 #include "portcon.h"
 #include "gpio_hal.h"
 
+// BK4819 3-wire interface timing: the datasheet minimums rounded up with
+// margin, turned into core cycles at compile time. Every edge is a single
+// GPIOC store, the pads only make up what the stores don't already take.
+struct BK4819SPITiming {
+    static constexpr uint32_t CPU_MHZ = 48;
+    static constexpr uint32_t STORE_CYCLES = 2;     // STR to GPIOC
+
+    static constexpr uint32_t SCN_SETUP_NS = 100;   // SCN low to the first SCL rise
+    static constexpr uint32_t SCN_HOLD_NS = 100;    // last SCL fall to SCN high
+    static constexpr uint32_t SCL_HIGH_NS = 100;
+    static constexpr uint32_t SCL_LOW_NS = 100;     // covers SDA setup too
+    static constexpr uint32_t TURNAROUND_NS = 200;  // SDA released to the first read bit
+
+    // Cycles to wait after a store for ns to have passed
+    static constexpr uint32_t pad(uint32_t ns) {
+        uint32_t cycles = (ns * CPU_MHZ + 999) / 1000;
+        return cycles > STORE_CYCLES ? cycles - STORE_CYCLES : 0;
+    }
+};
+
 class SPISoftwareInterface {
 public:
 
@@ -15,116 +36,97 @@ public:
         GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
     }
 
-    // Method to write to a register
-    void writeRegister(uint8_t reg, uint16_t value) {
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        delay250ns(1);
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-        spiWriteU8(reg);
-        spiWriteU16(value);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-        delay250ns(1);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+    // Method to write to a register. The transfers are unrolled and run
+    // from RAM, one copy of each rather than one per call site.
+    RAMFUNC void writeRegister(uint8_t reg, uint16_t value) {
+        uint32_t port = select();
+        shiftOut((uint32_t)(reg << 16) | value, port, std::make_index_sequence<24>{});
+        deselect(port);
     }
 
     // Method to read from a register
-    uint16_t readRegister(uint8_t reg) {
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        delay250ns(1);
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-        spiWriteU8(reg | 0x80);
-        uint16_t value = spiReadU16();
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-        delay250ns(1);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-        return value;
-    }
-
-private:
-    uint16_t spiReadU16(void) {
-        uint16_t value = 0;
+    RAMFUNC uint16_t readRegister(uint8_t reg) {
+        uint32_t port = select();
+        shiftOut(reg | 0x80U, port, std::make_index_sequence<8>{});
+        GPIO_Write(&GPIOC->DATA, port);
 
         // Enable input on PORTC pin C2
         PORTCON_PORTC_IE = (PORTCON_PORTC_IE & ~PORTCON_PORTC_IE_C2_MASK) | PORTCON_PORTC_IE_C2_BITS_ENABLE;
         GPIOC->DIR = (GPIOC->DIR & ~GPIO_DIR_2_MASK) | GPIO_DIR_2_BITS_INPUT;
+        GPIO_Wait(Timing::pad(Timing::TURNAROUND_NS));
 
-        delay250ns(1);
-
-        // Read 16 bits from the SPI
-        for (int i = 0; i < 16; i++) {
-            value = (value << 1) | (GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA) ? 1 : 0);
-
-            // Generate clock pulse
-            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-            delay250ns(1);
-            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-            delay250ns(1);
-        }
+        uint16_t value = (uint16_t)shiftIn(port, std::make_index_sequence<16>{});
 
         // Restore default configuration
         PORTCON_PORTC_IE = (PORTCON_PORTC_IE & ~PORTCON_PORTC_IE_C2_MASK) | PORTCON_PORTC_IE_C2_BITS_DISABLE;
         GPIOC->DIR = (GPIOC->DIR & ~GPIO_DIR_2_MASK) | GPIO_DIR_2_BITS_OUTPUT;
 
+        deselect(port);
         return value;
     }
 
-    void spiWriteU8(uint8_t data) {
-        // Ensure clock is initially low
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-
-        for (int i = 0; i < 8; i++) {
-            // Set SDA based on the MSB of the data
-            if (data & 0x80) {
-                GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-            }
-            else {
-                GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-            }
-
-            // Create the clock pulse
-            delay250ns(1);
-            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-            delay250ns(1);
-
-            // Shift data to the left to prepare for the next bit
-            data <<= 1;
-
-            // Lower the clock signal
-            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-            delay250ns(1);
-        }
+private:
+    using Timing = BK4819SPITiming;
+
+    static constexpr uint32_t SCN = 1U << GPIOC_PIN_BK4819_SCN;
+    static constexpr uint32_t SCL = 1U << GPIOC_PIN_BK4819_SCL;
+    static constexpr uint32_t SDA = 1U << GPIOC_PIN_BK4819_SDA;
+
+    // Starts a frame and returns GPIOC with the bus pins low. The other pins
+    // of the port keep the state read here until deselect(): a change made to
+    // them in between would be undone. The GPIOC outputs (audio path,
+    // flashlight) are therefore only driven from the task that owns the
+    // BK4819, see Radio::toggleSpeaker(), and by the fatal error hooks, where
+    // nothing else runs any more.
+    uint32_t select(void) {
+        uint32_t port = GPIOC->DATA & ~(SCN | SCL | SDA);
+        GPIO_Write(&GPIOC->DATA, port | SCN);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOC->DATA, port);
+        GPIO_Wait(Timing::pad(Timing::SCN_SETUP_NS));
+        return port;
     }
 
+    void deselect(uint32_t port) {
+        GPIO_Write(&GPIOC->DATA, port);
+        GPIO_Wait(Timing::pad(Timing::SCN_HOLD_NS));
+        GPIO_Write(&GPIOC->DATA, port | SCN);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOC->DATA, port | SCN | SCL | SDA);
+    }
 
-    void spiWriteU16(uint16_t data) {
-        // Ensure clock is initially low
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-
-        for (int i = 0; i < 16; i++) {
-            // Set SDA based on the MSB of the data
-            if (data & 0x8000) {
-                GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-            }
-            else {
-                GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-            }
+    // One bit, MSB first: data out with SCL low, the BK4819 samples on the
+    // rising edge. SCL is left high.
+    template <uint8_t Bit>
+    static inline __attribute__((always_inline)) void writeBit(uint32_t data, uint32_t port) {
+        uint32_t sda = (data & (1UL << Bit)) ? SDA : 0;
+        GPIO_Write(&GPIOC->DATA, port | sda);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        GPIO_Write(&GPIOC->DATA, port | sda | SCL);
+        GPIO_Wait(Timing::pad(Timing::SCL_HIGH_NS));
+    }
 
-            // Generate clock pulse
-            delay250ns(1);
-            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-            delay250ns(1);
+    // Sample before raising SCL, the BK4819 moves to the next bit on the edge
+    static inline __attribute__((always_inline)) uint32_t readBit(uint32_t port) {
+        uint32_t bit = GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+        GPIO_Write(&GPIOC->DATA, port | SCL);
+        GPIO_Wait(Timing::pad(Timing::SCL_HIGH_NS));
+        GPIO_Write(&GPIOC->DATA, port);
+        GPIO_Wait(Timing::pad(Timing::SCL_LOW_NS));
+        return bit;
+    }
 
-            // Shift data to prepare for the next bit
-            data <<= 1;
+    // The bit loops are expanded at compile time, no counter or variable
+    // shift per bit
+    template <size_t... I>
+    static inline __attribute__((always_inline)) void shiftOut(uint32_t data, uint32_t port, std::index_sequence<I...>) {
+        (writeBit<sizeof...(I) - 1 - I>(data, port), ...);
+    }
 
-            // Lower the clock signal
-            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-            delay250ns(1);
-        }
+    template <size_t... I>
+    static inline __attribute__((always_inline)) uint32_t shiftIn(uint32_t port, std::index_sequence<I...>) {
+        uint32_t value = 0;
+        ((value = (value << 1) | readBit(port), (void)I), ...);
+        return value;
     }
 };
-
@@ -24,7 +24,7 @@ uint32_t getElapsedMilliseconds(void) {
 }
 
 
-void delay250ns(const uint32_t delay) {
+RAMFUNC void delay250ns(const uint32_t delay) {
     const uint32_t ticks = (delay * gTickMultiplier) >> 2;
     uint32_t i = 0;
     uint32_t Start = SysTick->LOAD;
@@ -44,7 +44,7 @@ void delay250ns(const uint32_t delay) {
     } while (i < ticks);
 }
 
-void delayUs(uint32_t delay) {
+RAMFUNC void delayUs(uint32_t delay) {
 	const uint32_t ticks = delay * gTickMultiplier;
 	uint32_t elapsed_ticks = 0;
 	uint32_t Start = SysTick->LOAD;
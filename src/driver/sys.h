@@ -3,6 +3,16 @@
 #include <cstdlib>
 #include <cstddef>
 
+// Runs from SRAM: bus bit loops and busy waits get no flash wait states,
+// so their timing is fast and repeatable. The code is copied there at
+// startup (see linker/firmware.ld); calls from flash go through a register
+// since RAM is out of BL range.
+#if defined(__arm__)
+#define RAMFUNC __attribute__((section(".ramfunc"), long_call, noinline))
+#else
+#define RAMFUNC __attribute__((noinline))
+#endif
+
 uint32_t getElapsedMilliseconds(void);
 
 void configureSysTick(void);
@@ -13,8 +23,8 @@ void boardPORTCONInit(void);
 void boardADCInit(void);
 void boardADCGetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent);
 
-void delay250ns(const uint32_t delay);
-void delayUs(uint32_t delay);
+RAMFUNC void delay250ns(const uint32_t delay);
+RAMFUNC void delayUs(uint32_t delay);
 void delayMs(uint32_t delay);
 
 void AESEncrypt(const void *pKey, const void *pIv, const void *pIn, void *pOut, uint8_t NumBlocks);
@@ -17,8 +17,114 @@ extern "C" {
 
 class ST7565 : public U8G2 {
 public:
+    static constexpr uint8_t PAGES = 8;
+
+#if defined(ENABLE_DISPLAY_PAGE_BUFFER)
+    // Two page buffer, 256 bytes: a frame is drawn in four passes
+    static constexpr uint8_t BUFFER_PAGES = 2;
+
+    ST7565() : U8G2() {
+        u8g2_Setup_st7565_64128n_2(&u8g2, U8G2_R0, u8x8_hw_spi_cb, u8x8_gpio_and_delay_cb);
+    }
+#else
+    static constexpr uint8_t BUFFER_PAGES = PAGES;
+
     ST7565() : U8G2() {
         u8g2_Setup_st7565_64128n_f(&u8g2, U8G2_R0, u8x8_hw_spi_cb, u8x8_gpio_and_delay_cb);
     }
-};
+#endif
+
+    bool begin(void) {
+        sentValid = false;
+        return U8G2::begin();
+    }
+
+    // Frame loop: beginFrame(), draw the whole screen, nextFramePage(), and
+    // draw again for as long as it returns true. u8g2 clips every pass to
+    // the pages in the buffer. Passes holding none of the pages set in
+    // "pages" are skipped, the display keeps what it shows there. Returns
+    // false when there is nothing to draw.
+    bool beginFrame(uint8_t pages) {
+        framePages = sentValid ? pages : 0xFF;
+        return selectPass(0);
+    }
+
+    // Sends what changed in the pass just drawn and moves to the next one
+    bool nextFramePage(void) {
+        sendChanges();
+        if (!selectPass(bufferRow + BUFFER_PAGES)) {
+            sentValid = true;
+            return false;
+        }
+        return true;
+    }
 
+    // First display page in the buffer
+    uint8_t getBufferRow(void) const { return bufferRow; }
+
+    // The display RAM no longer matches the last frame sent
+    void resendAll(void) { sentValid = false; }
+
+private:
+    static constexpr uint8_t SEGMENTS = 8;
+    static constexpr uint8_t SEGMENT_TILES = 16 / SEGMENTS;    // 8 columns per tile
+    static constexpr uint8_t SEGMENT_BYTES = SEGMENT_TILES * 8;
+    static constexpr uint8_t PASS_MASK = (uint8_t)((1U << BUFFER_PAGES) - 1U);
+
+    // A hash per segment of what the display holds instead of a 1 KB copy
+    uint32_t sentHash[PAGES][SEGMENTS] = {};
+    bool sentValid = false;
+    uint8_t framePages = 0xFF;
+    uint8_t bufferRow = 0;
+
+    bool selectPass(uint8_t row) {
+        while (row < PAGES && !(framePages & (PASS_MASK << row))) {
+            row += BUFFER_PAGES;
+        }
+        if (row >= PAGES) {
+            return false;
+        }
+        bufferRow = row;
+        if (BUFFER_PAGES < PAGES) {
+            u8g2_SetBufferCurrTileRow(&u8g2, row);
+        }
+        clearBuffer();
+        return true;
+    }
+
+    // Per page of the buffer, sends the column run from the first to the
+    // last segment that changed since it was last sent
+    void sendChanges(void) {
+        uint8_t* page = getBufferPtr();
+
+        for (uint8_t row = bufferRow; row < bufferRow + BUFFER_PAGES; row++, page += SEGMENTS * SEGMENT_BYTES) {
+            uint8_t first = SEGMENTS;
+            uint8_t last = 0;
+
+            for (uint8_t segment = 0; segment < SEGMENTS; segment++) {
+                uint32_t hash = segmentHash(page + segment * SEGMENT_BYTES);
+                if (!sentValid || hash != sentHash[row][segment]) {
+                    sentHash[row][segment] = hash;
+                    if (first == SEGMENTS) {
+                        first = segment;
+                    }
+                    last = segment;
+                }
+            }
+
+            if (first < SEGMENTS) {
+                u8x8_DrawTile(u8g2_GetU8x8(&u8g2), (uint8_t)(first * SEGMENT_TILES), row, (uint8_t)((last - first + 1) * SEGMENT_TILES),
+                    page + first * SEGMENT_BYTES);
+            }
+        }
+    }
+
+    // FNV-1a
+    static uint32_t segmentHash(const uint8_t* data) {
+        uint32_t hash = 2166136261UL;
+        for (uint8_t i = 0; i < SEGMENT_BYTES; i++) {
+            hash = (hash ^ data[i]) * 16777619UL;
+        }
+        return hash;
+    }
+};
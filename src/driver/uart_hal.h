@@ -151,6 +151,14 @@ public:
 
 private:
 
+    // First 0xAB from index up to the DMA write position, or that position
+    static RAMFUNC uint16_t scanForHeader(uint16_t index, uint16_t dmaLength) {
+        while (index != dmaLength && UART_DMA_Buffer[index] != 0xABU) {
+            index = (index + 1) % BufferSize;
+        }
+        return index;
+    }
+
     void sendReply(void* pReply, uint16_t size) {
         Header_t header;
         Footer_t footer;
@@ -285,6 +293,7 @@ private:
         reply.data.size   = pCmd->size;
         
         settings.getEEPROM().readBuffer(pCmd->offset, reply.data.data, pCmd->size);
+        settings.overlayRadioSettings(pCmd->offset, reply.data.data, pCmd->size);
 
         sendReply(&reply, reply.header.size + sizeof(reply.header));
 
@@ -321,11 +330,7 @@ private:
         reply.data.offset = pCmd->offset;
 
         // Write data to EEPROM               
-        settings.getEEPROM().writeBuffer(pCmd->offset, pCmd->data, pCmd->size);
-        
-        if(pCmd->offset == 0x0000) {
-            settings.getRadioSettings();  
-        }
+        settings.writeImage(pCmd->offset, pCmd->data, pCmd->size);
 
         sendReply(&reply, sizeof(reply));
     }
@@ -351,11 +356,17 @@ private:
 
 
 public:    
+    bool isScreenStreaming() const {
+        return sendScreenData;
+    }
 
-    void sendScreenBuffer(const void* buffer, uint32_t size) {
+    // A frame can come in parts, the dump header goes before the first one
+    void sendScreenBuffer(const void* buffer, uint32_t size, bool frameStart = true) {
         const uint16_t screenDumpIdByte = 0xEDAB;
         if (sendScreenData) {
-            send(&screenDumpIdByte, 2);
+            if (frameStart) {
+                send(&screenDumpIdByte, 2);
+            }
             send(buffer, size);
         }
     }
@@ -379,9 +390,7 @@ public:
             }
 
             // Advance to the next potential command start
-            while (writeIndex != dmaLength && UART_DMA_Buffer[writeIndex] != 0xABU) {
-                writeIndex = (writeIndex + 1) % BufferSize;
-            }
+            writeIndex = scanForHeader(writeIndex, dmaLength);
 
             if (writeIndex == dmaLength) {
                 return false;
@@ -483,6 +492,8 @@ public:
             break;
 
         case 0x05DD: // Reset command
+            // Staged EEPROM writes must be on the part before a reset
+            settings.getEEPROM().flush();
             //NVIC_SystemReset();
             break;
         case 0x0A03:
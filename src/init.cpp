@@ -31,7 +31,11 @@ extern uint32_t __bss_end__[];
 extern uint8_t flash_data_start[];
 extern uint8_t sram_data_start[];
 extern uint8_t sram_data_end[];
+extern uint8_t flash_ramfunc_start[];
+extern uint8_t sram_ramfunc_start[];
+extern uint8_t sram_ramfunc_end[];
 
+extern "C" void RAMFUNC_Init();
 extern "C" void DATA_Init();
 extern "C" void BSS_Init();
 
@@ -43,6 +47,17 @@ void BSS_Init(void) {
 	}
 }
 
+// Runs before anything in .ramfunc can be called
+void RAMFUNC_Init(void) {
+	volatile uint32_t* pCodeRam = (volatile uint32_t*)sram_ramfunc_start;
+	volatile uint32_t* pCodeFlash = (volatile uint32_t*)flash_ramfunc_start;
+	uint32_t           Size = (uint32_t)sram_ramfunc_end - (uint32_t)sram_ramfunc_start;
+
+	for (unsigned int i = 0; i < (Size / 4); i++) {
+		*pCodeRam++ = *pCodeFlash++;
+	}
+}
+
 void DATA_Init(void) {
 	volatile uint32_t* pDataRam = (volatile uint32_t*)sram_data_start;
 	volatile uint32_t* pDataFlash = (volatile uint32_t*)flash_data_start;
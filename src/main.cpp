@@ -96,7 +96,9 @@ extern "C" {
 }
 #endif
 
-StackType_t systemTaskStack[configMINIMAL_STACK_SIZE];
+// The system task also updates and draws the apps, which the timer daemon
+// did before: same depth
+StackType_t systemTaskStack[configTIMER_TASK_STACK_DEPTH];
 StaticTask_t systemTaskBuffer;
 
 int main(void) {
@@ -2,6 +2,7 @@
 #include <algorithm>
 
 #include "radio.h"
+#include "text_format.h"
 #include "sys.h"
 #include "gpio.h"
 #include "system.h"
@@ -52,7 +53,7 @@ int16_t Radio::convertRSSIToPlusDB(int16_t rssi_dBm) {
     return 0; // Return 0 if not greater than S9
 }
 
-void Radio::setPowerSaveMode() {
+void Radio::setPowerSaveModeImpl(void) {
     if (inPowerSaveMode) {
         return;
     }
@@ -62,20 +63,25 @@ void Radio::setPowerSaveMode() {
     bk4819.setSleepMode();
 }
 
-void Radio::setNormalPowerMode() {
+void Radio::setNormalPowerModeImpl(void) {
     if (!inPowerSaveMode) {
         return;
     }
 
     bk4819.rxTurnOn();
     inPowerSaveMode = false;
-    delayMs(5); // Give the audio path a moment to wake up
+    wait(5); // Give the audio path a moment to wake up
 }
 
-void Radio::setActiveVFO(Settings::VFOAB vfo) {
+void Radio::setActiveVFOImpl(Settings::VFOAB vfo) {
     activeVFO = vfo;
     rxVFO = vfo;
-    setupToVFO(vfo);
+    setupToVFOImpl(vfo);
+}
+
+void Radio::setRXVFOImpl(Settings::VFOAB vfo) {
+    rxVFO = vfo;
+    tuneToVFO(vfo, false);
 }
 
 void Radio::toggleSpeaker(bool on) {
@@ -94,36 +100,76 @@ void Radio::setSquelch(uint32_t f, uint8_t sql) {
 }
 
 void Radio::setVFO(Settings::VFOAB vfo, uint32_t rx, uint32_t tx, int16_t channel, ModType modulation) {
-    uint8_t vfoIndex = (uint8_t)vfo;
-    radioVFO[vfoIndex].rx.frequency = rx;
-    radioVFO[vfoIndex].tx.frequency = tx;
-    radioVFO[vfoIndex].channel = channel;
-    radioVFO[vfoIndex].squelch = 1;
-    radioVFO[vfoIndex].step = Settings::Step::STEP_12_5kHz;
-    radioVFO[vfoIndex].modulation = modulation;
-    radioVFO[vfoIndex].bw = BK4819_Filter_Bandwidth::BK4819_FILTER_BW_20k;
-    radioVFO[vfoIndex].power = Settings::TXOutputPower::TX_POWER_LOW;
-    radioVFO[vfoIndex].shift = Settings::OffsetDirection::OFFSET_NONE;
-    radioVFO[vfoIndex].repeaterSte = Settings::ONOFF::OFF;
-    radioVFO[vfoIndex].ste = Settings::ONOFF::OFF;
-    radioVFO[vfoIndex].compander = Settings::TXRX::OFF;
-    radioVFO[vfoIndex].pttid = 0;
-    radioVFO[vfoIndex].rxagc = 18;
-    radioVFO[vfoIndex].rx.codeType = Settings::CodeType::NONE;
-    radioVFO[vfoIndex].rx.code = 0;
-    radioVFO[vfoIndex].tx.codeType = Settings::CodeType::NONE;
-    radioVFO[vfoIndex].tx.code = 0;
+    Settings::VFO update = radioVFO[(uint8_t)vfo];
+    update.rx.frequency = rx;
+    update.tx.frequency = tx;
+    update.channel = channel;
+    update.squelch = 1;
+    update.step = Settings::Step::STEP_12_5kHz;
+    update.modulation = modulation;
+    update.bw = BK4819_Filter_Bandwidth::BK4819_FILTER_BW_20k;
+    update.power = Settings::TXOutputPower::TX_POWER_LOW;
+    update.shift = Settings::OffsetDirection::OFFSET_NONE;
+    update.repeaterSte = Settings::ONOFF::OFF;
+    update.ste = Settings::ONOFF::OFF;
+    update.compander = Settings::TXRX::OFF;
+    update.pttid = 0;
+    update.rxagc = 18;
+    update.rx.codeType = Settings::CodeType::NONE;
+    update.rx.code = 0;
+    update.tx.codeType = Settings::CodeType::NONE;
+    update.tx.code = 0;
 
     if (channel > 0) {
-        snprintf(radioVFO[vfoIndex].name, sizeof(radioVFO[vfoIndex].name), "CH-%03d", channel);
+        Fmt::format(update.name, sizeof(update.name), "CH-", Fmt::zero<3>((uint32_t)channel));
     }
     else {
-        strncpy(radioVFO[vfoIndex].name, getBandName(rx), sizeof(radioVFO[vfoIndex].name) - 1);
-        radioVFO[vfoIndex].name[sizeof(radioVFO[vfoIndex].name) - 1] = '\0'; // Ensure null termination
+        strncpy(update.name, getBandName(rx), sizeof(update.name) - 1);
+        update.name[sizeof(update.name) - 1] = '\0'; // Ensure null termination
+    }
+    publishVFO((uint8_t)vfo, update);
+}
+
+void Radio::setVFOImpl(Settings::VFOAB vfoab, const Settings::VFO& vfo) {
+    Settings::VFO update = vfo;
+
+    bool hasCustomName = update.name[0] != '\0' &&
+                         update.name[0] != (char)0xFF;
+
+    if (update.channel > 0) {
+        if (!hasCustomName) {
+            Fmt::format(update.name, sizeof(update.name), "CH-", Fmt::zero<3>((uint32_t)update.channel));
+        } else {
+            update.name[sizeof(update.name) - 1] = '\0';
+        }
+    } else {
+        strncpy(update.name, getBandName(update.rx.frequency), sizeof(update.name) - 1);
+        update.name[sizeof(update.name) - 1] = '\0'; // Ensure null termination
     }
+    publishVFO((uint8_t)vfoab, update);
+    setupToVFOImpl(vfoab);
+}
+
+void Radio::publishVFO(uint8_t vfoIndex, const Settings::VFO& vfo) {
+    taskENTER_CRITICAL();
+    radioVFO[vfoIndex] = vfo;
+    taskEXIT_CRITICAL();
+}
+
+void Radio::setupToVFOImpl(Settings::VFOAB vfo) {
+    recordProfile(vfo);
+    tuneToVFO(vfo, true);
 }
 
-void Radio::setupToVFO(Settings::VFOAB vfo) {
+// Record what this VFO needs from the BK4819, switching back to it later
+// only sends the registers that differ
+void Radio::recordProfile(Settings::VFOAB vfo) {
+    bk4819.beginProfile(vfoProfile[(uint8_t)vfo]);
+    configureVFO(vfo);
+    bk4819.endProfile();
+}
+
+void Radio::configureVFO(Settings::VFOAB vfo) {
     uint8_t vfoIndex = (uint8_t)vfo;
 
     bk4819.squelchType(SquelchType::SQUELCH_RSSI_NOISE_GLITCH);
@@ -136,15 +182,31 @@ void Radio::setupToVFO(Settings::VFOAB vfo) {
 
     const bool isAM = radioVFO[vfoIndex].modulation == ModType::MOD_AM;
     if (isAM && static_cast<uint8_t>(radioVFO[vfoIndex].bw) > static_cast<uint8_t>(BK4819_Filter_Bandwidth::BK4819_FILTER_BW_14k)) {
+        taskENTER_CRITICAL();
         radioVFO[vfoIndex].bw = BK4819_Filter_Bandwidth::BK4819_FILTER_BW_14k; // tighten AM passband to cut noise
+        taskEXIT_CRITICAL();
     }
 
     bk4819.setAGC(true, isAM, radioVFO[vfoIndex].rxagc);
     bk4819.setFilterBandwidth(radioVFO[vfoIndex].bw, isAM); // keep weak-signal bandwidth the same on AM
 
-    bk4819.rxTurnOn();
-
     setupToneDetection(vfo);
+}
+
+void Radio::tuneToVFO(Settings::VFOAB vfo, bool powerUp) {
+    uint8_t vfoIndex = (uint8_t)vfo;
+
+    if (!bk4819.isProfileCurrent(vfoProfile[vfoIndex])) {
+        recordProfile(vfo);
+    }
+    if (!bk4819.applyProfile(vfoProfile[vfoIndex])) {
+        configureVFO(vfo); // too many writes to record, or never set up
+    }
+
+    // The power up sequence waits 10 ms, a receiver already on only retunes
+    if (powerUp || !bk4819.isRxOn()) {
+        bk4819.rxTurnOn();
+    }
 
     bk4819.tuneTo(radioVFO[vfoIndex].rx.frequency, true);
 }
@@ -171,14 +233,15 @@ void Radio::toggleRX(bool on, Settings::CodeType codeType = Settings::CodeType::
 
     if (on) {
         if (inPowerSaveMode) {
-            setNormalPowerMode();
+            setNormalPowerModeImpl();
         }
 
         if (state != Settings::RadioState::RX_ON) {
             bk4819.toggleGreen(true);
             toggleBK4819(true);
             state = Settings::RadioState::RX_ON;
-            systask.pushMessage(System::SystemTask::SystemMSG::MSG_RADIO_RX, 0);
+            sampleStatus();
+            systask.notifyRadioRX();
         }
 
         if (radioVFO[vfoIndex].modulation == ModType::MOD_FM &&
@@ -195,12 +258,12 @@ void Radio::toggleRX(bool on, Settings::CodeType codeType = Settings::CodeType::
             bk4819.toggleGreen(false);
             toggleBK4819(false);
             state = Settings::RadioState::IDLE;
-            systask.pushMessage(System::SystemTask::SystemMSG::MSG_RADIO_IDLE, 0);
+            systask.notifyRadioIdle();
         }
     }
 }
 
-bool Radio::sendFSKMessage(const char* msg) {
+bool Radio::sendFSKMessageImpl(const char* msg) {
     if (!msg || !msg[0]) {
         return false;
     }
@@ -303,7 +366,7 @@ bool Radio::sendFSKMessage(const char* msg) {
     bk4819.writeRaw(BK4819_REG_59, static_cast<uint16_t>((1u << 15) | (1u << 14) | fsk_reg59));
     bk4819.writeRaw(BK4819_REG_59, fsk_reg59);
 
-    delayMs(100); // let things settle
+    wait(100); // let things settle
     // Build and load a padded packet into FIFO (little-endian words)
     uint8_t packet[PACKET_LEN] = { 0 };
     packet[0] = 'M';
@@ -328,7 +391,7 @@ bool Radio::sendFSKMessage(const char* msg) {
     uint16_t timeout = 500;
     bool done = false;
     while (timeout-- > 0) {
-        delayMs(5);
+        wait(5);
         if (bk4819.getInterruptRequest() & 1u) {
             bk4819.clearInterrupt();
             uint16_t flags = bk4819.readInterrupt();
@@ -339,7 +402,7 @@ bool Radio::sendFSKMessage(const char* msg) {
         }
     }
 
-    delayMs(100); // let things settle
+    wait(100); // let things settle
     // Disable FSK TX
     bk4819.writeRaw(BK4819_REG_59, fsk_reg59);
     bk4819.disableTxPath();
@@ -352,7 +415,7 @@ bool Radio::sendFSKMessage(const char* msg) {
     return done;
 }
 
-bool Radio::startTX() {
+bool Radio::startTXImpl(void) {
     uint8_t vfoIndex = (uint8_t)getCurrentVFO();
     uint32_t txFrequency = radioVFO[vfoIndex].tx.frequency ? radioVFO[vfoIndex].tx.frequency : radioVFO[vfoIndex].rx.frequency;
 
@@ -376,7 +439,7 @@ bool Radio::startTX() {
         return true;
     }
 
-    setNormalPowerMode();
+    setNormalPowerModeImpl();
     toggleSpeaker(false);
     bk4819.toggleGreen(false);
     bk4819.toggleRed(true);
@@ -401,7 +464,7 @@ bool Radio::startTX() {
     return true;
 }
 
-void Radio::stopTX() {
+void Radio::stopTXImpl(void) {
     if (state != Settings::RadioState::TX_ON) {
         return;
     }
@@ -423,7 +486,7 @@ void Radio::stopTX() {
     bk4819.toggleGreen(false);
 
     state = Settings::RadioState::IDLE;
-    systask.pushMessage(System::SystemTask::SystemMSG::MSG_RADIO_IDLE, 0);
+    systask.notifyRadioIdle();
 }
 
 void Radio::sendRogerTone(uint8_t rogerSetting) {
@@ -441,7 +504,7 @@ void Radio::sendRogerTone(uint8_t rogerSetting) {
     bk4819.setAF(BK4819_AF::BEEP);
     bk4819.enableTone1(96);
     bk4819.setToneFrequency(toneHz);
-    delayMs(durationMs);
+    wait(durationMs);
     bk4819.disableTones();
     bk4819.setAF(BK4819_AF::MUTE);
 }
@@ -466,12 +529,12 @@ void Radio::applyTxCode(uint8_t vfoIndex) {
     }
 }
 
-void Radio::playBeep(Settings::BEEPType beep) {
+void Radio::playBeepImpl(Settings::BEEPType beep) {
     bool isSpeakerWasOn = speakerOn;
     uint16_t toneConfig = bk4819.getToneRegister();
 
     if (inPowerSaveMode) {
-        setNormalPowerMode();
+        setNormalPowerModeImpl();
     }
 
     // validate Radio state
@@ -480,7 +543,7 @@ void Radio::playBeep(Settings::BEEPType beep) {
     }
 
     toggleSpeaker(false);
-    delayMs(20);
+    wait(20);
 
     uint16_t toneFrequency;
     switch (beep)
@@ -509,25 +572,25 @@ void Radio::playBeep(Settings::BEEPType beep) {
     }
 
     bk4819.playTone(toneFrequency, true);
-    delayMs(2);
+    wait(2);
     toggleSpeaker(true);
-    delayMs(60);
+    wait(60);
 
     uint16_t duration;
     switch (beep)
     {
     case Settings::BEEPType::BEEP_880HZ_60MS_TRIPLE_BEEP:
         bk4819.exitTxMute();
-        delayMs(60);
+        wait(60);
         bk4819.enterTxMute();
-        delayMs(20);
+        wait(20);
         [[fallthrough]];
     case Settings::BEEPType::BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL:
     case Settings::BEEPType::BEEP_500HZ_60MS_DOUBLE_BEEP:
         bk4819.exitTxMute();
-        delayMs(60);
+        wait(60);
         bk4819.enterTxMute();
-        delayMs(20);
+        wait(20);
         [[fallthrough]];
     case Settings::BEEPType::BEEP_1KHZ_60MS_OPTIONAL:
         bk4819.exitTxMute();
@@ -550,13 +613,13 @@ void Radio::playBeep(Settings::BEEPType beep) {
         break;
     }
 
-    delayMs(duration);
+    wait(duration);
     bk4819.enterTxMute();
-    delayMs(20);
+    wait(20);
     toggleSpeaker(false);
-    delayMs(5);
+    wait(5);
     bk4819.turnsOffTonesTurnsOnRX();
-    delayMs(5);
+    wait(5);
     bk4819.setToneRegister(toneConfig);
 
     toggleSpeaker(isSpeakerWasOn);
@@ -586,7 +649,7 @@ void Radio::runDualWatch(void) {
         }
         else {
             dualWatchTimer = dualWatchTime;
-            setRXVFO((rxVFO == Settings::VFOAB::VFOA) ? Settings::VFOAB::VFOB : Settings::VFOAB::VFOA);
+            setRXVFOImpl((rxVFO == Settings::VFOAB::VFOA) ? Settings::VFOAB::VFOB : Settings::VFOAB::VFOA);
             timeoutPSDualWatch = 10;
         }
     }
@@ -645,117 +708,270 @@ void Radio::setupToneDetection(Settings::VFOAB vfo) {
     bk4819.setInterrupt(interruptMask);
 }
 
-void Radio::checkRadioInterrupts(void) {
-
-    while (bk4819.getInterruptRequest() & 1u) { // BK chip interrupt request
-
-        bk4819.clearInterrupt();                       // then acknowledge/clear latch
-
-        union {
-            struct InterruptFlags {
-                uint16_t __UNUSED : 1;
-                uint16_t fskRxSync : 1;
-                uint16_t sqlLost : 1;
-                uint16_t sqlFound : 1;
-                uint16_t voxLost : 1;
-                uint16_t voxFound : 1;
-                uint16_t ctcssLost : 1;
-                uint16_t ctcssFound : 1;
-                uint16_t cdcssLost : 1;
-                uint16_t cdcssFound : 1;
-                uint16_t cssTailFound : 1;
-                uint16_t dtmf5ToneFound : 1;
-                uint16_t fskFifoAlmostFull : 1;
-                uint16_t fskRxFinied : 1;
-                uint16_t fskFifoAlmostEmpty : 1;
-                uint16_t fskTxFinied : 1;
-            } flags;
-            uint16_t __raw;
-        } interrupts;
-
-        interrupts.__raw = bk4819.readInterrupt();   // read latched flags first
-
-        uart.print("%0.16b\n", interrupts);        
-
-        /* if (interrupts.flags.fskRxFinied) {
-             uart.sendLog("FSK RX Finished");
-         }
-
-         if (interrupts.flags.fskTxFinied) {
-             uart.sendLog("FSK TX Finished");
-         }
-
-         if (interrupts.flags.fskFifoAlmostFull) {
-             uart.sendLog("FSK FIFO Almost Full");
-         }
-
-         if (interrupts.flags.fskFifoAlmostEmpty) {
-             uart.sendLog("FSK FIFO Almost Empty");
-         }
-
-         if (interrupts.flags.fskRxSync) {
-             uart.sendLog("FSK RX Sync");
-         }
-
-         if (interrupts.flags.voxLost) {
-             uart.sendLog("VOX Lost");
-         }
-
-         if (interrupts.flags.voxFound) {
-             uart.sendLog("VOX Found");
-         }
-
-         if (interrupts.flags.dtmf5ToneFound) {
-             uart.sendLog("DTMF 5 Tone Found");
-         }
-         */
-
-        if (interrupts.flags.cssTailFound) {
-            //uart.sendLog("CSS Tail Found");
-            toggleRX(false);
-        }
+void Radio::startTask(void) {
+    if (radioTask) {
+        return;
+    }
+    commandQueue = xQueueCreateStatic(commandQueueLength, sizeof(RadioCommand), commandQueueStorage, &commandQueueBuffer);
+    replySemaphore = xSemaphoreCreateBinaryStatic(&replySemaphoreBuffer);
+    replyMutex = xSemaphoreCreateMutexStatic(&replyMutexBuffer);
+    radioTask = xTaskCreateStatic(
+        Radio::runRadioTask,
+        "RADIO",
+        ARRAY_SIZE(radioTaskStack),
+        this,
+        2 + tskIDLE_PRIORITY,
+        radioTaskStack,
+        &radioTaskBuffer
+    );
+}
 
-        if (interrupts.flags.ctcssLost) {
-            //uart.sendLog("CTCSS Lost");
-            rxToneDetected = true;
-            toggleRX(true, Settings::CodeType::CT);
-        }
+void Radio::runRadioTask(void* pvParameters) {
+    Radio* radio = static_cast<Radio*>(pvParameters);
+    if (radio) {
+        radio->radioTaskImpl();
+    }
+}
 
-        if (interrupts.flags.ctcssFound) {
-            //uart.sendLog("CTCSS Found");
-            rxToneDetected = false;
-            toggleRX(false, Settings::CodeType::CT);
-        }
+bool Radio::send(const RadioCommand& command, bool reply) {
+    if (inRadioTask()) {
+        return runCommand(command);
+    }
+
+    // The radio task is above the caller, it has usually run the command by
+    // the time this returns
+    if (!reply) {
+        xQueueSend(commandQueue, &command, portMAX_DELAY);
+        return true;
+    }
+    xSemaphoreTake(replyMutex, portMAX_DELAY);
+    xQueueSend(commandQueue, &command, portMAX_DELAY);
+    xSemaphoreTake(replySemaphore, portMAX_DELAY);
+    bool result = replyResult;
+    xSemaphoreGive(replyMutex);
+    return result;
+}
+
+bool Radio::runCommand(const RadioCommand& command) {
+    switch (command.command) {
+    case Command::SET_VFO:
+        setVFOImpl((Settings::VFOAB)command.value, command.vfo);
+        break;
+    case Command::SETUP_VFO:
+        setupToVFOImpl((Settings::VFOAB)command.value);
+        break;
+    case Command::SET_ACTIVE_VFO:
+        setActiveVFOImpl((Settings::VFOAB)command.value);
+        break;
+    case Command::SET_RX_VFO:
+        setRXVFOImpl((Settings::VFOAB)command.value);
+        break;
+    case Command::START_TX:
+        return startTXImpl();
+    case Command::STOP_TX:
+        stopTXImpl();
+        break;
+    case Command::POWER_SAVE:
+        setPowerSaveModeImpl();
+        break;
+    case Command::NORMAL_POWER:
+        setNormalPowerModeImpl();
+        break;
+    case Command::PLAY_BEEP:
+        playBeepImpl((Settings::BEEPType)command.value);
+        break;
+    case Command::FSK_RX:
+        setFSKRxEnabledImpl(command.value != 0);
+        break;
+    case Command::SEND_FSK:
+        return sendFSKMessageImpl(command.text);
+    }
+    return true;
+}
+
+// Beeps and FSK bursts last long: the radio task sleeps through them rather
+// than holding off every other task
+void Radio::wait(uint32_t ms) {
+    if (radioTask && xTaskGetCurrentTaskHandle() == radioTask) {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+    }
+    else {
+        delayMs(ms);
+    }
+}
+
+TickType_t Radio::pollPeriod(TickType_t sinceEvent) const {
+    if (state == Settings::RadioState::RX_ON || fskRxEnabled || sinceEvent < pdMS_TO_TICKS(irqActiveHoldMs)) {
+        return pdMS_TO_TICKS(irqPollActiveMs);
+    }
+    if (inPowerSaveMode && !isDualWatchScanning()) {
+        return pdMS_TO_TICKS(irqPollSleepMs);
+    }
+    return pdMS_TO_TICKS(irqPollIdleMs);
+}
+
+void Radio::sampleStatus(void) {
+    Status sample;
+    sample.rssi = bk4819.getRSSI();
+    sample.noise = bk4819.getNoise();
+    sample.glitch = bk4819.getGlitch();
+    sample.squelchOpen = bk4819.isSquelchOpen();
 
-        if (interrupts.flags.cdcssLost) {
-            //uart.sendLog("CDCSS Lost");
-            rxToneDetected = true;
-            toggleRX(true, Settings::CodeType::DCS);
+    taskENTER_CRITICAL();
+    status = sample;
+    taskEXIT_CRITICAL();
+}
+
+// There is no BK4819 interrupt line to the MCU on these radios, so the latch
+// in REG_0C is polled, faster while something is going on. Commands wake the
+// task straight away.
+void Radio::radioTaskImpl(void) {
+    RadioCommand command;
+    TickType_t lastEvent = xTaskGetTickCount();
+    TickType_t lastDualWatch = lastEvent;
+    TickType_t lastSample = lastEvent;
+
+    for (;;) {
+        if (xQueueReceive(commandQueue, &command, pollPeriod(xTaskGetTickCount() - lastEvent)) == pdTRUE) {
+            bool result = runCommand(command);
+            if (command.command == Command::START_TX || command.command == Command::SEND_FSK) {
+                replyResult = result;
+                xSemaphoreGive(replySemaphore);
+            }
+            configASSERT(uxTaskGetStackHighWaterMark(nullptr) > radioTaskStackMarginWords);
         }
 
-        if (interrupts.flags.cdcssFound) {
-            //uart.sendLog("CDCSS Found");
-            rxToneDetected = false;
-            toggleRX(false, Settings::CodeType::CT);
+        if (!radioReady) {
+            continue;
         }
 
-        if (interrupts.flags.sqlLost) {
-            //uart.sendLog("SQL Lost");
-            toggleRX(true);
+        while (bk4819.getInterruptRequest() & 1u) { // BK chip interrupt request
+            bk4819.clearInterrupt();                // then acknowledge/clear latch
+            handleInterrupts(bk4819.readInterrupt());
+            lastEvent = xTaskGetTickCount();
         }
 
-        if (interrupts.flags.sqlFound) {
-            //uart.sendLog("SQL Found");
-            rxToneDetected = false;
-            toggleRX(false);
+        TickType_t now = xTaskGetTickCount();
+
+        if (state == Settings::RadioState::RX_ON && now - lastSample >= pdMS_TO_TICKS(statusSampleMs)) {
+            sampleStatus();
+            lastSample = now;
         }
 
-        if (fskRxEnabled && (interrupts.flags.fskRxSync || interrupts.flags.fskRxFinied || interrupts.flags.fskFifoAlmostFull || interrupts.flags.fskTxFinied)) {
-            handleFSKInterrupts(interrupts.__raw);
-            uart.print("FSK : %0.16b\n", interrupts);
+        // Dual watch is left alone while UART1 is busy
+        if (now - lastDualWatch >= pdMS_TO_TICKS(dualWatchStepMs)) {
+            lastDualWatch = now;
+            if (!systask.isUARTBusy()) {
+                runDualWatch();
+            }
         }
+    }
+}
+
+void Radio::handleInterrupts(uint16_t flags) {
 
+    union {
+        struct InterruptFlags {
+            uint16_t __UNUSED : 1;
+            uint16_t fskRxSync : 1;
+            uint16_t sqlLost : 1;
+            uint16_t sqlFound : 1;
+            uint16_t voxLost : 1;
+            uint16_t voxFound : 1;
+            uint16_t ctcssLost : 1;
+            uint16_t ctcssFound : 1;
+            uint16_t cdcssLost : 1;
+            uint16_t cdcssFound : 1;
+            uint16_t cssTailFound : 1;
+            uint16_t dtmf5ToneFound : 1;
+            uint16_t fskFifoAlmostFull : 1;
+            uint16_t fskRxFinied : 1;
+            uint16_t fskFifoAlmostEmpty : 1;
+            uint16_t fskTxFinied : 1;
+        } flags;
+        uint16_t __raw;
+    } interrupts;
+
+    interrupts.__raw = flags;
+
+    //uart.print("%0.16b\n", interrupts);
+
+    /* if (interrupts.flags.fskRxFinied) {
+         uart.sendLog("FSK RX Finished");
+     }
+
+     if (interrupts.flags.fskTxFinied) {
+         uart.sendLog("FSK TX Finished");
+     }
+
+     if (interrupts.flags.fskFifoAlmostFull) {
+         uart.sendLog("FSK FIFO Almost Full");
+     }
+
+     if (interrupts.flags.fskFifoAlmostEmpty) {
+         uart.sendLog("FSK FIFO Almost Empty");
+     }
+
+     if (interrupts.flags.fskRxSync) {
+         uart.sendLog("FSK RX Sync");
+     }
+
+     if (interrupts.flags.voxLost) {
+         uart.sendLog("VOX Lost");
+     }
+
+     if (interrupts.flags.voxFound) {
+         uart.sendLog("VOX Found");
+     }
+
+     if (interrupts.flags.dtmf5ToneFound) {
+         uart.sendLog("DTMF 5 Tone Found");
+     }
+     */
+
+    if (interrupts.flags.cssTailFound) {
+        //uart.sendLog("CSS Tail Found");
+        toggleRX(false);
+    }
+
+    if (interrupts.flags.ctcssLost) {
+        //uart.sendLog("CTCSS Lost");
+        rxToneDetected = true;
+        toggleRX(true, Settings::CodeType::CT);
+    }
+
+    if (interrupts.flags.ctcssFound) {
+        //uart.sendLog("CTCSS Found");
+        rxToneDetected = false;
+        toggleRX(false, Settings::CodeType::CT);
+    }
+
+    if (interrupts.flags.cdcssLost) {
+        //uart.sendLog("CDCSS Lost");
+        rxToneDetected = true;
+        toggleRX(true, Settings::CodeType::DCS);
+    }
+
+    if (interrupts.flags.cdcssFound) {
+        //uart.sendLog("CDCSS Found");
+        rxToneDetected = false;
+        toggleRX(false, Settings::CodeType::CT);
+    }
+
+    if (interrupts.flags.sqlLost) {
+        //uart.sendLog("SQL Lost");
+        toggleRX(true);
+    }
+
+    if (interrupts.flags.sqlFound) {
+        //uart.sendLog("SQL Found");
+        rxToneDetected = false;
+        toggleRX(false);
+    }
 
+    if (fskRxEnabled && (interrupts.flags.fskRxSync || interrupts.flags.fskRxFinied || interrupts.flags.fskFifoAlmostFull || interrupts.flags.fskTxFinied)) {
+        handleFSKInterrupts(interrupts.__raw);
+        //uart.print("FSK : %0.16b\n", interrupts);
     }
 }
 
@@ -934,7 +1150,7 @@ void Radio::handleFSKInterrupts(uint16_t flags) {
     }
 }
 
-void Radio::setFSKRxEnabled(bool enable) {
+void Radio::setFSKRxEnabledImpl(bool enable) {
     if (enable == fskRxEnabled) {
         return;
     }
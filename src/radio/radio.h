@@ -4,6 +4,11 @@
 
 #include <stdio.h>
 
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
 #include "bk4819.h"
 #include "uart_hal.h"
 #include "misc.h"
@@ -21,8 +26,6 @@ namespace RadioNS
 
         /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
-        Settings::VFO radioVFO[2];
-
         struct FrequencyBand {
             char name[11];
             uint32_t lower_freq;
@@ -32,40 +35,25 @@ namespace RadioNS
 
         Radio(System::SystemTask& systask, UART& uart, BK4819& bk4819, Settings& settings) : systask{ systask }, uart{ uart }, bk4819{ bk4819 }, settings{ settings } {};
 
-        void toggleSpeaker(bool on);
+        void setupToVFO(Settings::VFOAB vfo) { post(Command::SETUP_VFO, (uint32_t)vfo); }
 
-        void setSquelch(uint32_t f, uint8_t sql);
-        void setFilterBandwidth(BK4819_Filter_Bandwidth bw, bool keepWeakSame = false) { bk4819.setFilterBandwidth(bw, keepWeakSame); }
-        void setVFO(Settings::VFOAB vfo, uint32_t rx, uint32_t tx, int16_t channel, ModType modulation);
-        void setupToVFO(Settings::VFOAB vfo);
+        void playBeep(Settings::BEEPType beep) { post(Command::PLAY_BEEP, (uint32_t)beep); }
 
-        void playBeep(Settings::BEEPType beep);
-
-        // get VFO
-        Settings::VFO getActiveVFO() { return radioVFO[(uint8_t)activeVFO]; };
-        Settings::VFO getVFO(Settings::VFOAB vfo) { return radioVFO[(uint8_t)vfo]; };
+        // get VFO, a copy the radio task cannot change halfway through
+        Settings::VFO getActiveVFO() { return getVFO(activeVFO); };
+        Settings::VFO getVFO(Settings::VFOAB vfo) {
+            taskENTER_CRITICAL();
+            Settings::VFO copy = radioVFO[(uint8_t)vfo];
+            taskEXIT_CRITICAL();
+            return copy;
+        };
         void setVFO(Settings::VFOAB vfoab, Settings::VFO vfo) {
-            uint8_t vfoIndex = (uint8_t)vfoab;
-            radioVFO[vfoIndex] = vfo;
-
-            bool hasCustomName = radioVFO[vfoIndex].name[0] != '\0' &&
-                                 radioVFO[vfoIndex].name[0] != (char)0xFF;
-
-            if (radioVFO[vfoIndex].channel > 0) {
-                if (!hasCustomName) {
-                    snprintf(radioVFO[vfoIndex].name, sizeof(radioVFO[vfoIndex].name), "CH-%03d", radioVFO[vfoIndex].channel);
-                } else {
-                    radioVFO[vfoIndex].name[sizeof(radioVFO[vfoIndex].name) - 1] = '\0';
-                }
-            } else {
-                strncpy(radioVFO[vfoIndex].name, getBandName(radioVFO[vfoIndex].rx.frequency), sizeof(radioVFO[vfoIndex].name) - 1);
-                radioVFO[vfoIndex].name[sizeof(radioVFO[vfoIndex].name) - 1] = '\0'; // Ensure null termination
-            }
-            setupToVFO(vfoab);
+            RadioCommand command = { Command::SET_VFO, (uint32_t)vfoab, nullptr, vfo };
+            send(command);
         };
         // get active VFO
         Settings::VFOAB getCurrentVFO(void) { return activeVFO; };
-        void setActiveVFO(Settings::VFOAB vfo);
+        void setActiveVFO(Settings::VFOAB vfo) { post(Command::SET_ACTIVE_VFO, (uint32_t)vfo); }
 
         // Change Active VFO
         void changeActiveVFO(void) {
@@ -74,30 +62,51 @@ namespace RadioNS
 
         Settings::VFOAB getRXVFO(void) { return rxVFO; };
 
+        void setRXVFO(Settings::VFOAB vfo) { post(Command::SET_RX_VFO, (uint32_t)vfo); }
 
-        void setRXVFO(Settings::VFOAB vfo) {
-            rxVFO = vfo;
-            setupToVFO(vfo);
+        // Blocks the caller until the packet is out
+        bool sendFSKMessage(const char* msg) {
+            RadioCommand command = { Command::SEND_FSK, 0, msg, {} };
+            return send(command, true);
         }
-
-        bool sendFSKMessage(const char* msg);
-        void handleFSKInterrupts(uint16_t flags);
-        void setFSKRxEnabled(bool enable);
+        void setFSKRxEnabled(bool enable) { post(Command::FSK_RX, enable); }
         bool popFSKMessage(char* out, uint8_t maxLen);
 
-        void toggleRX(bool on, Settings::CodeType codeType);
-        void checkRadioInterrupts(void);
+        // The radio task owns the BK4819 once started: it polls the
+        // interrupt latch, runs dual watch and carries out the commands the
+        // methods above and below post to it. Until then, and from the task
+        // itself, they run in place.
+        void startTask(void);
+        static void runRadioTask(void* pvParameters);
 
         Settings::RadioState getState() { return state; }
-        bool startTX();
-        void stopTX();
+        bool startTX() {
+            RadioCommand command = { Command::START_TX, 0, nullptr, {} };
+            return send(command, true);
+        }
+        void stopTX() { post(Command::STOP_TX); }
         bool isTXActive() const { return state == Settings::RadioState::TX_ON; }
-        void sendRogerTone(uint8_t rogerSetting);
 
-        uint16_t getRSSI() { return bk4819.getRSSI(); }
+        // Signal readings the radio task takes while receiving, read without
+        // touching the bus
+        struct Status {
+            uint16_t rssi;
+            uint8_t noise;
+            uint8_t glitch;
+            bool squelchOpen;
+        };
+
+        Status getStatus(void) const {
+            taskENTER_CRITICAL();
+            Status copy = status;
+            taskEXIT_CRITICAL();
+            return copy;
+        }
+
+        uint16_t getRSSI() { return getStatus().rssi; }
 
         int16_t getRSSIdBm(void) {
-            uint16_t rssi = bk4819.getRSSI();
+            uint16_t rssi = getStatus().rssi;
             int16_t rssidbm = (int16_t)((rssi / 2) - 160);
             // TODO: RSSI gRxVfo->Band
             return rssidbm + dBmCorrTable[6];
@@ -106,7 +115,7 @@ namespace RadioNS
         uint8_t convertRSSIToSLevel(int16_t rssi_dBm);
         int16_t convertRSSIToPlusDB(int16_t rssi_dBm);
 
-        void runDualWatch(void);
+        bool isDualWatchScanning(void) const { return dualWatch && state == Settings::RadioState::IDLE; }
 
         const char* getBandName(uint32_t frequency) {
             int num_bands = sizeof(radioBands) / sizeof(radioBands[0]);
@@ -120,18 +129,16 @@ namespace RadioNS
             return "";
         }
 
-        void setupToneDetection(Settings::VFOAB vfo);
-
         bool isRXToneDetected(void) { return rxToneDetected; }
 
         bool isRadioReady(void) { return radioReady; }
         void setRadioReady(bool ready) { radioReady = ready; }
         
-        void setPowerSaveMode();
+        void setPowerSaveMode() { post(Command::POWER_SAVE); }
 
         bool isPowerSaveMode(void) { return inPowerSaveMode; }
 
-        void setNormalPowerMode();
+        void setNormalPowerMode() { post(Command::NORMAL_POWER); }
 
     private:
         System::SystemTask& systask;
@@ -139,6 +146,10 @@ namespace RadioNS
         BK4819& bk4819;
         Settings& settings;
 
+        // Written only by the radio task, under a critical section so that
+        // getVFO() never copies half an update
+        Settings::VFO radioVFO[2];
+
         bool inPowerSaveMode = false;
 
         bool dualWatch = true;
@@ -147,6 +158,101 @@ namespace RadioNS
 
         static constexpr uint8_t dualWatchTime = 50;
 
+        static constexpr uint8_t dualWatchStepMs = 5;   // one dualWatchTimer count
+
+        // Interrupt polling period of the radio task: short while a signal
+        // or FSK is being received and for a while after any event, long
+        // while the BK4819 mostly sleeps
+        static constexpr uint8_t irqPollActiveMs = 2;
+        static constexpr uint8_t irqPollIdleMs = 5;
+        static constexpr uint8_t irqPollSleepMs = 20;
+        static constexpr uint16_t irqActiveHoldMs = 200;
+
+        static constexpr uint8_t statusSampleMs = 50;
+
+        Status status = {};
+
+        // Deepest path is SEND_FSK (packet buffer) or SET_VFO (profile
+        // recording) plus an exception frame; radioTaskImpl() asserts the
+        // margin after every command
+        static constexpr uint16_t radioTaskStackWords = 320;
+        static constexpr uint16_t radioTaskStackMarginWords = 32;
+
+        TaskHandle_t radioTask = nullptr;
+        StaticTask_t radioTaskBuffer;
+        StackType_t radioTaskStack[radioTaskStackWords];
+
+        // Commands for the radio task. The replies of START_TX and SEND_FSK
+        // come back through replySemaphore; replyMutex keeps a second caller
+        // from queueing its request until the first has its reply.
+        enum class Command : uint8_t {
+            SET_VFO,
+            SETUP_VFO,
+            SET_ACTIVE_VFO,
+            SET_RX_VFO,
+            START_TX,
+            STOP_TX,
+            POWER_SAVE,
+            NORMAL_POWER,
+            PLAY_BEEP,
+            FSK_RX,
+            SEND_FSK,
+        };
+
+        struct RadioCommand {
+            Command command;
+            uint32_t value;
+            const char* text;       // SEND_FSK
+            Settings::VFO vfo;      // SET_VFO
+        };
+
+        static constexpr uint8_t commandQueueLength = 6;
+
+        QueueHandle_t commandQueue = nullptr;
+        StaticQueue_t commandQueueBuffer;
+        uint8_t commandQueueStorage[commandQueueLength * sizeof(RadioCommand)];
+        SemaphoreHandle_t replySemaphore = nullptr;
+        StaticSemaphore_t replySemaphoreBuffer;
+        SemaphoreHandle_t replyMutex = nullptr;
+        StaticSemaphore_t replyMutexBuffer;
+        bool replyResult = false;
+
+        bool send(const RadioCommand& command, bool reply = false);
+        void post(Command command, uint32_t value = 0) {
+            RadioCommand radioCommand = { command, value, nullptr, {} };
+            send(radioCommand);
+        }
+        bool runCommand(const RadioCommand& command);
+        bool inRadioTask(void) const { return !radioTask || xTaskGetCurrentTaskHandle() == radioTask; }
+        void wait(uint32_t ms);
+
+        void radioTaskImpl(void);
+        TickType_t pollPeriod(TickType_t sinceEvent) const;
+        void sampleStatus(void);
+
+        void setVFOImpl(Settings::VFOAB vfoab, const Settings::VFO& vfo);
+        void setupToVFOImpl(Settings::VFOAB vfo);
+        void setActiveVFOImpl(Settings::VFOAB vfo);
+        void setRXVFOImpl(Settings::VFOAB vfo);
+        bool startTXImpl(void);
+        void stopTXImpl(void);
+        void setPowerSaveModeImpl(void);
+        void setNormalPowerModeImpl(void);
+        void playBeepImpl(Settings::BEEPType beep);
+        void setFSKRxEnabledImpl(bool enable);
+        bool sendFSKMessageImpl(const char* msg);
+
+        // BK4819 access, radio task only
+        void setSquelch(uint32_t f, uint8_t sql);
+        void setVFO(Settings::VFOAB vfo, uint32_t rx, uint32_t tx, int16_t channel, ModType modulation);
+        void toggleRX(bool on, Settings::CodeType codeType);
+        void handleInterrupts(uint16_t flags);
+        void handleFSKInterrupts(uint16_t flags);
+        void runDualWatch(void);
+        void setupToneDetection(Settings::VFOAB vfo);
+        void sendRogerTone(uint8_t rogerSetting);
+        void publishVFO(uint8_t vfoIndex, const Settings::VFO& vfo);
+
         bool rxToneDetected = false;
 
         bool radioReady = false;
@@ -200,7 +306,15 @@ namespace RadioNS
         bool txCalLoaded = false;
         bool txCalHasValid = false;
 
+        // BK4819 register writes for each VFO, see setupToVFO()
+        BK4819::RegisterProfile vfoProfile[2];
+
         void toggleBK4819(bool on);
+        // GPIOC, so only from the radio task (see SPISoftwareInterface)
+        void toggleSpeaker(bool on);
+        void configureVFO(Settings::VFOAB vfo);
+        void recordProfile(Settings::VFOAB vfo);
+        void tuneToVFO(Settings::VFOAB vfo, bool powerUp);
 
         uint32_t DCSCalculateGolay(uint32_t codeWord) {
             unsigned int i;
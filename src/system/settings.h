@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstddef>  // For offsetof
 #include <cstdint>  // For standard integer types like uint16_t, uint8_t
 #include <cstring>
 #include "bk4819.h" // For BK4819 specific types like BK4819_Filter_Bandwidth and ModType
 #include "sys.h"    // For system-level definitions or utilities
 #include "eeprom.h" // For EEPROM read/write operations
+#include "option_table.h" // For the compile time indexed option strings
 
 /*
     EEPROM Layout Overview:
@@ -13,7 +15,7 @@
     [0x0000 - 0x004F] : Global Radio Settings (defined by SETTINGS struct, approx 80 bytes)
     [0x0050 - 0x1D0F] : Memory Channels (e.g., 230 channels * 32 bytes/channel = 7360 bytes = 0x1CC0 bytes)
                        (End address would be 0x0050 + 0x1CC0 - 1 = 0x1D0F)
-    [0x1D10 - 0x1DFF] : Empty / Unused space
+    [0x1D10 - 0x1DFF] : Settings journal (7 one-page entries from 0x1D20, see appendJournal)
     [0x1E00 - ... ]   : Calibration Data
     ...
     [0x1FFF]          : End of a typical 8KB EEPROM (like 24C64)
@@ -27,25 +29,25 @@ class Settings {
 public:
     static constexpr uint16_t MAX_CHANNELS = 230;
 
-    static constexpr const char* squelchStr = "OFF\n1\n2\n3\n4\n5\n6\n7\n8\n9"; ///< Squelch level options.
-    static constexpr const char* codetypeStr = "NONE\nCT\nDCS\n-DCS"; ///< CTCSS/DCS code type options (-DCS for inverted DCS).
-    static constexpr const char* txrxStr = "OFF\nTX\nRX\nRX/TX"; ///< Options for features applicable to TX, RX, or both (e.g., compander).
-    static constexpr const char* onoffStr = "OFF\nON"; ///< Simple ON/OFF options.
-    static constexpr const char* powerStr = "LOW\nMID\nHIGH"; ///< Transmit power level options.
-    static constexpr const char* offsetStr = "OFF\n+\n-"; ///< Repeater offset direction options.
-    static constexpr const char* modulationStr = "FM\nAM\nLSB"; ///< Modulation type options (subset shown).
-    // static constexpr const char* modulationStr = "FM\nAM\nLSB\nUSB\nBYP\nRAW\nWFM\nPRST"; // Full list
-    static constexpr const char* bandwidthStr = "26\n23\n20\n17\n14\n12\n10\n9\n7\n6"; ///< Filter bandwidth options (in kHz).
-    static constexpr const char* stepStr = "0.5\n1.0\n2.5\n5.0\n6.25\n10.0\n12.5\n15.0\n20.0\n25.0\n30.0\n50.0\n100.0\n500.0"; ///< Frequency step options (in kHz).
-    static constexpr const char* AGCStr = "-43\n-40\n-38\n-35\n-33\n-30\n-28\n-25\n-23\n-20\n-18\n-15\n-13\n-11\n-9\n-6\n-4\n-2\nAUTO"; ///< AGC gain options (in dB, or AUTO).
-    static constexpr const char* rogerStr = "OFF\nDEFAULT\nMOTO TPT"; ///< Roger beep type options.
-    static constexpr const char* pttIDStr = "OFF\nQUINDAR\nUP CODE\nDOWN CODE\nUP & DOWN"; ///< PTT ID options.
-    static constexpr const char* TXTimeoutStr = "30s\n1m\n2m\n4m\n6m\n8m"; ///< Transmit Time-Out Timer options.
-    static constexpr const char* BacklightTimeStr = "OFF\nON\n5s\n10s\n15s\n20s\n30s\n1m\n2m\n4m"; ///< Backlight auto-off timer options.
-    static constexpr const char* MicDBStr = "+1.1dB\n+4.0dB\n+8.0dB\n+12.0dB\n+15.1dB"; ///< Microphone gain options.
-    static constexpr const char* BacklightModeStr = "OFF\nTX\nRX\nTX/RX"; ///< Backlight activation mode options.
-    static constexpr const char* BacklightLevelStr = "0\n1\n2\n3\n4\n5\n6\n7\n8\n9\n10"; ///< Backlight brightness levels.
-    static constexpr const char* LCDContrastStr = "100\n110\n120\n130\n140\n150\n160\n170\n180\n190\n200"; ///< LCD contrast options.
+    static constexpr OptionTable<"OFF\n1\n2\n3\n4\n5\n6\n7\n8\n9"> squelchStr{}; ///< Squelch level options.
+    static constexpr OptionTable<"NONE\nCT\nDCS\n-DCS"> codetypeStr{}; ///< CTCSS/DCS code type options (-DCS for inverted DCS).
+    static constexpr OptionTable<"OFF\nTX\nRX\nRX/TX"> txrxStr{}; ///< Options for features applicable to TX, RX, or both (e.g., compander).
+    static constexpr OptionTable<"OFF\nON"> onoffStr{}; ///< Simple ON/OFF options.
+    static constexpr OptionTable<"LOW\nMID\nHIGH"> powerStr{}; ///< Transmit power level options.
+    static constexpr OptionTable<"OFF\n+\n-"> offsetStr{}; ///< Repeater offset direction options.
+    static constexpr OptionTable<"FM\nAM\nLSB"> modulationStr{}; ///< Modulation type options (subset shown).
+    // static constexpr OptionTable<"FM\nAM\nLSB\nUSB\nBYP\nRAW\nWFM\nPRST"> modulationStr{}; // Full list
+    static constexpr OptionTable<"26\n23\n20\n17\n14\n12\n10\n9\n7\n6"> bandwidthStr{}; ///< Filter bandwidth options (in kHz).
+    static constexpr OptionTable<"0.5\n1.0\n2.5\n5.0\n6.25\n10.0\n12.5\n15.0\n20.0\n25.0\n30.0\n50.0\n100.0\n500.0"> stepStr{}; ///< Frequency step options (in kHz).
+    static constexpr OptionTable<"-43\n-40\n-38\n-35\n-33\n-30\n-28\n-25\n-23\n-20\n-18\n-15\n-13\n-11\n-9\n-6\n-4\n-2\nAUTO"> AGCStr{}; ///< AGC gain options (in dB, or AUTO).
+    static constexpr OptionTable<"OFF\nDEFAULT\nMOTO TPT"> rogerStr{}; ///< Roger beep type options.
+    static constexpr OptionTable<"OFF\nQUINDAR\nUP CODE\nDOWN CODE\nUP & DOWN"> pttIDStr{}; ///< PTT ID options.
+    static constexpr OptionTable<"30s\n1m\n2m\n4m\n6m\n8m"> TXTimeoutStr{}; ///< Transmit Time-Out Timer options.
+    static constexpr OptionTable<"OFF\nON\n5s\n10s\n15s\n20s\n30s\n1m\n2m\n4m"> BacklightTimeStr{}; ///< Backlight auto-off timer options.
+    static constexpr OptionTable<"+1.1dB\n+4.0dB\n+8.0dB\n+12.0dB\n+15.1dB"> MicDBStr{}; ///< Microphone gain options.
+    static constexpr OptionTable<"OFF\nTX\nRX\nTX/RX"> BacklightModeStr{}; ///< Backlight activation mode options.
+    static constexpr OptionTable<"0\n1\n2\n3\n4\n5\n6\n7\n8\n9\n10"> BacklightLevelStr{}; ///< Backlight brightness levels.
+    static constexpr OptionTable<"100\n110\n120\n130\n140\n150\n160\n170\n180\n190\n200"> LCDContrastStr{}; ///< LCD contrast options.
 
     static constexpr uint16_t CTCSSOptions[50] = {
         670,  693,  719,  744,  770,  797,  825,  854,  885,  915,
@@ -257,7 +259,8 @@ public:
         uint16_t        memory[2];               // Memory Number
         VFO             vfo[2];                  // VFO Settings
         ONOFF           showVFO[2];              // Show VFO or Memory
-        uint8_t         reserved1[4] = {0xFF};   // Reserved
+        uint16_t        journalBase = 0x00FF;    // Last journal entry folded into this record
+        uint8_t         reserved1[2] = {};       // Reserved
     } __attribute__((packed));
 
     static_assert(sizeof(SETTINGS) == 80, "SETTINGS struct size mismatch");
@@ -267,16 +270,49 @@ public:
     Settings(System::SystemTask& systask) : systask{ systask }, eeprom() {}
     void factoryReset() {};
 
+    // The record at 0x0000 is the one factory reset and the CPS write, the
+    // newest journal entry holds the bytes saved since
     void getRadioSettings() {
         eeprom.readBuffer(0x0000, &radioSettings, sizeof(SETTINGS));
+        loadJournal();
         lastSavedRadioSettings = radioSettings;
     }
 
     void setRadioSettings() {
-        eeprom.writeBuffer(0x0000, &radioSettings, sizeof(SETTINGS));
+        appendJournal();
         lastSavedRadioSettings = radioSettings;
     }
 
+    // Raw EEPROM write from the CPS (UART 0x051D). A new record at 0x0000
+    // becomes the base with the journal folded in, so it also wins at the
+    // next boot. The journal belongs to the radio: an uploaded image carries
+    // an older copy of it, which would bring old settings back, so those
+    // bytes are dropped.
+    bool writeImage(uint32_t address, const uint8_t* data, uint16_t size) {
+        uint32_t end = address + size;
+        bool ok = true;
+        if (address < JOURNAL_START) {
+            uint32_t partEnd = end < JOURNAL_START ? end : JOURNAL_START;
+            ok = writeImagePart(address, data, static_cast<uint16_t>(partEnd - address)) && ok;
+        }
+        if (end > JOURNAL_END) {
+            uint32_t partStart = address > JOURNAL_END ? address : JOURNAL_END;
+            ok = writeImagePart(partStart, data + (partStart - address), static_cast<uint16_t>(end - partStart)) && ok;
+        }
+        return ok;
+    }
+
+    // CPS reads of the record at 0x0000 see the saved settings
+    void overlayRadioSettings(uint32_t address, uint8_t* data, uint16_t size) const {
+        if (!journalValid) {
+            return;
+        }
+        const uint8_t* saved = reinterpret_cast<const uint8_t*>(&lastSavedRadioSettings);
+        for (uint32_t at = address; at < address + size && at < sizeof(SETTINGS); at++) {
+            data[at - address] = saved[at];
+        }
+    }
+
     void setRadioSettingsDefault() {
         radioSettings.version           = settingsVersion;
         radioSettings.batteryType       = BatteryType::BAT_1600;
@@ -354,15 +390,24 @@ public:
                 memcpy(buffer, &radioSettings, sizeof(SETTINGS));
             }
 
-            eeprom.writeBuffer(initBlock * blockSize, buffer, sizeof(buffer));
+            if (eeprom.writeBuffer(initBlock * blockSize, buffer, sizeof(buffer))) {
+                updateChannelMap(initBlock * blockSize, buffer, sizeof(buffer));
+            }
+            else {
+                reloadChannelMap(initBlock * blockSize, sizeof(buffer));
+            }
             initBlock++;
+            if (initBlock == maxBlock) {
+                // Done is only shown once all of it is on the part
+                eeprom.flush();
+            }
         }
 
         return static_cast<uint8_t>((initBlock * 100) / maxBlock);
     }
 
     void saveRadioSettings() {
-        eeprom.writeBuffer(0x0000, &radioSettings, sizeof(SETTINGS));
+        appendJournal();
         lastSavedRadioSettings = radioSettings;
     }
 
@@ -500,7 +545,7 @@ public:
      * Write a channel to EEPROM
      * @param channelNumber Channel number (1-230)
      * @param channel Reference to VFO struct containing the data
-     * @return true if successful, false if channel number is invalid
+     * @return true if successful, false if channel number is invalid or the write failed
      */
     bool writeChannel(uint16_t channelNumber, const VFO& channel) {
         if (channelNumber < 1 || channelNumber > MAX_CHANNELS) {
@@ -535,10 +580,61 @@ public:
         packed.reserved_bytes[1] = 0xFF;
         packed.reserved_bytes[2] = 0xFF;
 
-        eeprom.writeBuffer(address, &packed, sizeof(PackedVFOData));
+        if (!eeprom.writeBuffer(address, &packed, sizeof(PackedVFOData))) {
+            reloadChannelMap(address, sizeof(PackedVFOData));
+            return false;
+        }
+        setChannelInUse(channelNumber, isNameInUse(static_cast<uint8_t>(packed.name[0])));
         return true;
     }
 
+    /**
+     * Build the channel occupancy map from EEPROM, once at boot
+     * Only the first name byte of each record is read, a few bytes on the
+     * bus per channel instead of the whole 7360 byte area.
+     */
+    void loadChannelMap() {
+        reloadChannelMap(CHANNEL_START_ADDRESS, MAX_CHANNELS * CHANNEL_SIZE);
+    }
+
+    /**
+     * Re-read the occupancy of the channels named in a range, after a write
+     * that failed and may have stopped part way
+     * @param address Start of the range
+     * @param size Number of bytes
+     */
+    void reloadChannelMap(uint32_t address, uint32_t size) {
+        uint32_t end = address + size;
+        for (uint16_t ch = 1; ch <= MAX_CHANNELS; ch++) {
+            uint32_t nameAddress = channelNameAddress(ch);
+            if (nameAddress >= address && nameAddress < end) {
+                uint8_t first = 0;
+                eeprom.readBuffer(nameAddress, &first, sizeof(first));
+                setChannelInUse(ch, isNameInUse(first));
+            }
+        }
+    }
+
+    /**
+     * Keep the occupancy map in step with a raw EEPROM write
+     * @param address Address the data was written to
+     * @param data The bytes written
+     * @param size Number of bytes
+     */
+    void updateChannelMap(uint32_t address, const void* data, uint16_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint32_t end = address + size;
+        if (end <= CHANNEL_START_ADDRESS || address >= CHANNEL_START_ADDRESS + MAX_CHANNELS * CHANNEL_SIZE) {
+            return;
+        }
+        for (uint16_t ch = 1; ch <= MAX_CHANNELS; ch++) {
+            uint32_t nameAddress = channelNameAddress(ch);
+            if (nameAddress >= address && nameAddress < end) {
+                setChannelInUse(ch, isNameInUse(bytes[nameAddress - address]));
+            }
+        }
+    }
+
     /**
      * Check if a channel is in use (has a non-empty name)
      * @param channelNumber Channel number (1-230)
@@ -548,14 +644,9 @@ public:
         if (channelNumber < 1 || channelNumber > MAX_CHANNELS) {
             return false;
         }
-        
-        VFO channel;
-        if (!readChannel(channelNumber, channel)) {
-            return false;
-        }
-        
-        // Check if name is not empty (at least first character is not null or space)
-        return (channel.name[0] != '\0' && channel.name[0] != ' ');
+
+        uint16_t bit = static_cast<uint16_t>(channelNumber - 1);
+        return ((channelMap[bit / 32] >> (bit % 32)) & 1U) != 0;
     }
 
     /**
@@ -665,10 +756,8 @@ public:
      */
     uint16_t getChannelsInUseCount() {
         uint16_t count = 0;
-        for (uint16_t i = 1; i <= MAX_CHANNELS; i++) {
-            if (isChannelInUse(i)) {
-                count++;
-            }
+        for (uint32_t word : channelMap) {
+            count = static_cast<uint16_t>(count + __builtin_popcount(word));
         }
         return count;
     }
@@ -749,6 +838,160 @@ private:
     uint16_t initBlock = 0x0000;
     static constexpr uint16_t maxBlock = 0x000F;
 
+    // Settings journal. The record at 0x0000 is the base, each save appends
+    // a one-page entry with every settings byte that differs from it, so a
+    // save costs one page write and the newest entry alone gives the
+    // settings at boot. Entries go to the slots in turn: a save cut short
+    // by power loss only spoils its own slot, the entry before it still
+    // loads. When the differences outgrow an entry the settings go to the
+    // base instead, its journalBase marking the entries up to it as folded.
+    static constexpr uint16_t JOURNAL_START = 0x1D10;
+    static constexpr uint16_t JOURNAL_END = 0x1E00;
+    // The first 16 bytes share a page with channel 230, the slots start on
+    // the next page so that a torn write stays in its own slot
+    static constexpr uint16_t JOURNAL_FIRST_SLOT = (JOURNAL_START + EEPROM::PAGE_SIZE - 1) & ~(EEPROM::PAGE_SIZE - 1);
+    static constexpr uint8_t JOURNAL_SLOTS = (JOURNAL_END - JOURNAL_FIRST_SLOT) / EEPROM::PAGE_SIZE;
+    static constexpr uint8_t JOURNAL_BYTES = offsetof(SETTINGS, journalBase);
+    static constexpr uint8_t JOURNAL_MASK_BYTES = (JOURNAL_BYTES + 7) / 8;
+    static constexpr uint8_t JOURNAL_DATA_BYTES = EEPROM::PAGE_SIZE - 2 * sizeof(uint16_t) - JOURNAL_MASK_BYTES;
+
+    struct JournalEntry {
+        uint16_t sequence;
+        uint8_t mask[JOURNAL_MASK_BYTES];   // a bit per settings byte that differs from the base
+        uint8_t data[JOURNAL_DATA_BYTES];   // those bytes, in address order
+        uint16_t crc;
+    } __attribute__((packed));
+
+    static_assert(sizeof(JournalEntry) == EEPROM::PAGE_SIZE, "JournalEntry must fill one page");
+    static_assert(JOURNAL_SLOTS >= 2, "the journal needs an entry to fall back on");
+
+    bool journalValid = false;                  // an entry newer than the base is in use
+    uint8_t journalSlot = JOURNAL_SLOTS - 1;    // slot written last
+    uint16_t journalSequence = 0;               // newest entry, or the base's journalBase
+
+    static uint32_t journalAddress(uint8_t slot) {
+        return static_cast<uint32_t>(JOURNAL_FIRST_SLOT + slot * sizeof(JournalEntry));
+    }
+
+    // The CRC unit is shared with the UART command check
+    static uint16_t journalCRC(const JournalEntry& entry) {
+        taskENTER_CRITICAL();
+        uint16_t crc = CRCCalculate(&entry, offsetof(JournalEntry, crc));
+        taskEXIT_CRITICAL();
+        return crc;
+    }
+
+    static bool isJournalEntryValid(const JournalEntry& entry) {
+        if (entry.crc != journalCRC(entry)) {
+            return false;
+        }
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < JOURNAL_MASK_BYTES * 8; i++) {
+            if (entry.mask[i / 8] & (1U << (i % 8))) {
+                if (i >= JOURNAL_BYTES || ++count > JOURNAL_DATA_BYTES) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Applies the newest entry with a good CRC to radioSettings, read from
+    // the base before. False when no entry is newer than the base (erased,
+    // folded in, or an image from before the journal).
+    bool loadJournal() {
+        JournalEntry entry;
+        JournalEntry newest = {};
+        bool found = false;
+        journalSlot = JOURNAL_SLOTS - 1;
+        for (uint8_t slot = 0; slot < JOURNAL_SLOTS; slot++) {
+            eeprom.readBuffer(journalAddress(slot), &entry, sizeof(entry));
+            if (!isJournalEntryValid(entry)) {
+                continue;
+            }
+            if (found && static_cast<int16_t>(entry.sequence - newest.sequence) <= 0) {
+                continue;
+            }
+            newest = entry;
+            found = true;
+            journalSlot = slot;
+        }
+
+        journalSequence = radioSettings.journalBase;
+        journalValid = found && static_cast<int16_t>(newest.sequence - journalSequence) > 0;
+        if (journalValid) {
+            uint8_t* bytes = reinterpret_cast<uint8_t*>(&radioSettings);
+            uint8_t count = 0;
+            for (uint8_t i = 0; i < JOURNAL_BYTES; i++) {
+                if (newest.mask[i / 8] & (1U << (i % 8))) {
+                    bytes[i] = newest.data[count++];
+                }
+            }
+            journalSequence = newest.sequence;
+        }
+        return journalValid;
+    }
+
+    bool writeImagePart(uint32_t address, const uint8_t* data, uint16_t size) {
+        if (!eeprom.writeBuffer(address, data, size)) {
+            reloadChannelMap(address, size);
+            return false;
+        }
+        updateChannelMap(address, data, size);
+        if (address < sizeof(SETTINGS)) {
+            eeprom.readBuffer(0x0000, &radioSettings, sizeof(SETTINGS));
+            writeJournalBase();
+            lastSavedRadioSettings = radioSettings;
+        }
+        return true;
+    }
+
+    // Journals radioSettings: one entry when its differences from the base
+    // fit in it, a new base otherwise
+    bool appendJournal() {
+        SETTINGS base;
+        eeprom.readBuffer(0x0000, &base, sizeof(base));
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&radioSettings);
+        const uint8_t* baseBytes = reinterpret_cast<const uint8_t*>(&base);
+
+        JournalEntry entry = {};
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < JOURNAL_BYTES; i++) {
+            if (bytes[i] == baseBytes[i]) {
+                continue;
+            }
+            if (count == JOURNAL_DATA_BYTES) {
+                return writeJournalBase();
+            }
+            entry.mask[i / 8] = static_cast<uint8_t>(entry.mask[i / 8] | (1U << (i % 8)));
+            entry.data[count++] = bytes[i];
+        }
+        entry.sequence = static_cast<uint16_t>(journalSequence + 1);
+        entry.crc = journalCRC(entry);
+
+        uint8_t slot = static_cast<uint8_t>((journalSlot + 1) % JOURNAL_SLOTS);
+        if (!eeprom.writeBuffer(journalAddress(slot), &entry, sizeof(entry))) {
+            return false;
+        }
+        journalValid = true;
+        journalSlot = slot;
+        journalSequence = entry.sequence;
+        return true;
+    }
+
+    // Writes radioSettings to the base with every entry so far folded in.
+    // The pages go out in address order, journalBase in the last one: a
+    // write cut short leaves the old journalBase and the newest entry
+    // still applies on top.
+    bool writeJournalBase() {
+        radioSettings.journalBase = journalSequence;
+        if (!eeprom.writeBuffer(0x0000, &radioSettings, sizeof(SETTINGS))) {
+            return false;
+        }
+        journalValid = false;
+        return true;
+    }
+
     static constexpr uint8_t saveDelaySeconds = 5;
     static constexpr uint8_t saveDelayTicks = saveDelaySeconds * 2; // half-second ticks
 
@@ -765,4 +1008,28 @@ private:
     static constexpr uint16_t CHANNEL_START_ADDRESS = 0x0050;
     static constexpr uint16_t CHANNEL_SIZE = sizeof(PackedVFOData); // 32 bytes
 
+    // One bit per memory channel, set when its name is not empty
+    uint32_t channelMap[(MAX_CHANNELS + 31) / 32] = {};
+
+    // Empty names start with NUL, space or erased EEPROM, the same channels
+    // whose readChannel() name is empty (it turns a leading 0xFF into NUL)
+    static bool isNameInUse(uint8_t first) {
+        return first != 0x00 && first != ' ' && first != 0xFF;
+    }
+
+    static uint16_t channelNameAddress(uint16_t channelNumber) {
+        return static_cast<uint16_t>(CHANNEL_START_ADDRESS + (channelNumber - 1) * CHANNEL_SIZE + offsetof(PackedVFOData, name));
+    }
+
+    void setChannelInUse(uint16_t channelNumber, bool inUse) {
+        uint16_t bit = static_cast<uint16_t>(channelNumber - 1);
+        uint32_t mask = 1U << (bit % 32);
+        if (inUse) {
+            channelMap[bit / 32] |= mask;
+        }
+        else {
+            channelMap[bit / 32] &= ~mask;
+        }
+    }
+
 };
@@ -14,17 +14,19 @@ void SystemTask::runStatusTask(void* pvParameters) {
     }
 }
 
+// Both timers only wake the system task: the display transfer and the
+// settings saves may sleep and the timer daemon must not
 void SystemTask::appTimerCallback(TimerHandle_t xTimer) {
     SystemTask* systemTask = static_cast<SystemTask*>(pvTimerGetTimerID(xTimer));
     if (systemTask) {
-        systemTask->appTimerImpl();
+        systemTask->notify(NOTIFY_FRAME);
     }
 }
 
 void SystemTask::runTimerCallback(TimerHandle_t xTimer) {
     SystemTask* systemTask = static_cast<SystemTask*>(pvTimerGetTimerID(xTimer));
     if (systemTask) {
-        systemTask->runTimerImpl();
+        systemTask->notify(NOTIFY_RUN_TIMER);
     }
 }
 
@@ -66,6 +68,7 @@ void SystemTask::setupRadio(void) {
     } else {
         // Load settings from EEPROM
         settings.applyRadioSettings();
+        settings.loadChannelMap();
         // TODO: need to validate if load VFO or Memory
         radio.setVFO(Settings::VFOAB::VFOA, settings.radioSettings.vfo[(uint8_t)Settings::VFOAB::VFOA]);
         radio.setVFO(Settings::VFOAB::VFOB, settings.radioSettings.vfo[(uint8_t)Settings::VFOAB::VFOB]);
@@ -79,21 +82,25 @@ void SystemTask::setupRadio(void) {
 void SystemTask::pushMessage(SystemMSG msg, uint32_t value) {
     SystemMessages appMSG = { msg, value, (Keyboard::KeyCode)0, (Keyboard::KeyState)0 };
     xQueueSend(systemMessageQueue, (void*)&appMSG, 0);
+    notify(NOTIFY_MESSAGE);
 }
 
 void SystemTask::pushMessageKey(Keyboard::KeyCode key, Keyboard::KeyState state) {
     SystemMessages appMSG = { SystemMSG::MSG_KEYPRESSED, 0, key, state };
     xQueueSend(systemMessageQueue, (void*)&appMSG, 0);
+    notify(NOTIFY_MESSAGE);
 }
 
 void SystemTask::statusTaskImpl() {
-    SystemMessages notification;;
+    SystemMessages notification;
+
+    systemTaskHandle = xTaskGetCurrentTaskHandle();
 
     //uart.sendLog("System task started");
 
     battery.getReadings(); // Update battery readings
 
-    appTimer = xTimerCreateStatic("app", pdMS_TO_TICKS(100), pdTRUE, this, SystemTask::appTimerCallback, &appTimerBuffer);
+    appTimer = xTimerCreateStatic("app", pdMS_TO_TICKS(fastFramePeriodMs), pdTRUE, this, SystemTask::appTimerCallback, &appTimerBuffer);
     runTimer = xTimerCreateStatic("run", pdMS_TO_TICKS(runTimerPeriodMs), pdTRUE, this, SystemTask::runTimerCallback, &runTimerBuffer);    
 
     backlight.setBacklight(Backlight::backLightState::ON); // Turn on backlight    
@@ -103,6 +110,9 @@ void SystemTask::statusTaskImpl() {
     playBeep(Settings::BEEPType::BEEP_880HZ_200MS);
 
     setupRadio();
+    radio.startTask();
+    // Settings and channel saves are programmed in the background from here
+    settings.getEEPROM().startTask();
 
     // Validate the EEPROM content and initialize if necessary
     if (!settings.validateSettingsVersion()) {
@@ -118,18 +128,40 @@ void SystemTask::statusTaskImpl() {
     xTimerStart(appTimer, 0);
     xTimerStart(runTimer, 0);
     
-    //uart.print("lenght : %i\n", settings.stringLength(ui.generateCTDCList(Settings::DCSOptions, 104, false)));
     for (;;) {
         // Wait for notifications or messages
-        if (xQueueReceive(systemMessageQueue, &notification, pdMS_TO_TICKS(5)) == pdTRUE) {
+        uint32_t notified = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &notified, pdMS_TO_TICKS(uartBusy ? statusPollMs : statusIdlePollMs));
+
+        // Radio events first. With both bits set the order is lost, but
+        // neither handler depends on it.
+        bool gotMessage = (notified & (NOTIFY_RADIO_RX | NOTIFY_RADIO_IDLE)) != 0;
+        if (notified & NOTIFY_RADIO_RX) {
+            processSystemNotification({ SystemMSG::MSG_RADIO_RX, 0, (Keyboard::KeyCode)0, (Keyboard::KeyState)0 });
+        }
+        if (notified & NOTIFY_RADIO_IDLE) {
+            processSystemNotification({ SystemMSG::MSG_RADIO_IDLE, 0, (Keyboard::KeyCode)0, (Keyboard::KeyState)0 });
+        }
+
+        while (xQueueReceive(systemMessageQueue, &notification, 0) == pdTRUE) {
             // Process system notifications
             processSystemNotification(notification);
+            gotMessage = true;
+        }
+
+        if (notified & NOTIFY_RUN_TIMER) {
+            runTimerImpl();
         }
 
         bool handledUartCommand = false;
 
         taskENTER_CRITICAL();
-        if (uart.isCommandAvailable()) {
+        bool commandAvailable = uart.isCommandAvailable();
+        taskEXIT_CRITICAL();
+
+        // With interrupts on: an EEPROM write waits for the writer task
+        // when all its slots are taken
+        if (commandAvailable) {
             if (!uartBusy || ui.getInfoMessage() != UI::InfoMessageType::UART_COMM) {
                 infoMessageBeforeUART = ui.getInfoMessage();
             }
@@ -139,7 +171,6 @@ void SystemTask::statusTaskImpl() {
             handledUartCommand = true;
             uartIdleCycles = 0;
         }
-        taskEXIT_CRITICAL();
 
         // If we are currently busy or receiving bytes but a full command isn't ready, keep UART busy
         if (!handledUartCommand && uart.hasPendingData()) {
@@ -163,12 +194,16 @@ void SystemTask::statusTaskImpl() {
             }
         }
 
-        if (uartBusy) {
-            continue;
+        if (notified & NOTIFY_FRAME) {
+            appTimerImpl();
+        }
+
+        // Anything that came in may change the screen: a stopped app timer
+        // runs again, for at least one tick
+        if ((gotMessage || uartBusy) && framePace == FramePace::STOPPED) {
+            requestFrameBoost(1);
         }
 
-        radio.checkRadioInterrupts(); // Check for radio interrupts
-        radio.runDualWatch(); // Run dual watch
         //vTaskDelay(pdMS_TO_TICKS(1));
     }
 }
@@ -187,6 +222,7 @@ void SystemTask::processSystemNotification(SystemMessages notification) {
         }
         if (currentApp != Applications::Applications::None) {
             currentApplication->timeout();
+            currentApplication->invalidate();
         }
         if (keyboard.wasFKeyPressed()) {
             keyboard.clearFKeyPressed();
@@ -213,12 +249,14 @@ void SystemTask::processSystemNotification(SystemMessages notification) {
     case SystemMSG::MSG_RADIO_IDLE:
         powerSaveCount = 0;
         //uart.sendLog("MSG_RADIO_IDLE\n");
+        refreshScreen();
         break;
     case SystemMSG::MSG_RADIO_RX:
         //uart.sendLog("MSG_RADIO_RX\n");
         radio.setNormalPowerMode();
         powerSaveCount = 0;
         pushMessage(SystemMSG::MSG_BKCLIGHT, (uint32_t)Backlight::backLightState::ON);
+        refreshScreen();
         break;
     case SystemMSG::MSG_LOW_BATTERY:        
         ui.setInfoMessage(UI::InfoMessageType::LOW_BATTERY);
@@ -259,12 +297,15 @@ void SystemTask::processSystemNotification(SystemMessages notification) {
                 radio.stopTX();
                 ui.timeOut();
             }
+            refreshScreen();
             break;
         }
 
         if (currentApp != Applications::Applications::None) {
             currentApplication->action(key, state);
+            currentApplication->invalidate();
         }
+        requestFrameBoost();
 
         if (state == Keyboard::KeyState::KEY_PRESSED || state == Keyboard::KeyState::KEY_LONG_PRESSED) {
             timeoutCount = 0;
@@ -329,11 +370,81 @@ void SystemTask::runTimerImpl(void) {
 }
 
 void SystemTask::appTimerImpl(void) {
-    // Update the current application    
+    if (currentApp == Applications::Applications::None) {
+        return;
+    }
 
-    if (currentApp != Applications::Applications::None) {
+    // Update the current application
+    appUpdateElapsedMs = (uint16_t)(appUpdateElapsedMs + (framePace == FramePace::FAST ? fastFramePeriodMs : slowFramePeriodMs));
+    if (appUpdateElapsedMs >= appUpdatePeriodMs) {
+        appUpdateElapsedMs = 0;
         currentApplication->update();
     }
+
+    // The info popup is drawn over every app, and a new screen stream
+    // needs a first frame
+    if (ui.getInfoMessage() != shownInfoMessage) {
+        shownInfoMessage = ui.getInfoMessage();
+        currentApplication->invalidate();
+    }
+    if (uart.isScreenStreaming() != screenStreaming) {
+        screenStreaming = uart.isScreenStreaming();
+        currentApplication->invalidate();
+    }
+
+    uint8_t regions = currentApplication->takeInvalidRegions();
+    if (regions) {
+        currentApplication->drawScreen(regions);
+    }
+
+    FramePace pace = chooseFramePace();
+    if (pace != framePace) {
+        setFramePace(pace);
+    }
+}
+
+SystemTask::FramePace SystemTask::chooseFramePace(void) {
+    if (frameBoost) {
+        frameBoost = (uint8_t)(frameBoost - 1);
+        return FramePace::FAST;
+    }
+    // Held keys repeat and the RSSI meter moves
+    if (keyboard.isKeyHeld() || radio.getState() != Settings::RadioState::IDLE) {
+        return FramePace::FAST;
+    }
+    if (backlight.getBacklightState() == Backlight::backLightState::OFF && !uartBusy && !screenStreaming) {
+        return FramePace::STOPPED;
+    }
+    return FramePace::SLOW;
+}
+
+void SystemTask::setFramePace(FramePace pace) {
+    framePace = pace;
+    if (pace == FramePace::STOPPED) {
+        xTimerStop(appTimer, 0);
+    }
+    else {
+        // Also starts a stopped timer
+        xTimerChangePeriod(appTimer, pdMS_TO_TICKS(pace == FramePace::FAST ? fastFramePeriodMs : slowFramePeriodMs), 0);
+    }
+}
+
+void SystemTask::requestFrameBoost(uint8_t ticks) {
+    if (frameBoost < ticks) {
+        frameBoost = ticks;
+    }
+    // Not started yet, the timer begins at the fast pace
+    if (appTimer && framePace != FramePace::FAST) {
+        setFramePace(FramePace::FAST);
+    }
+}
+
+// The radio changed state: the app shows it, whether or not it asked
+void SystemTask::refreshScreen(void) {
+    if (currentApp != Applications::Applications::None) {
+        currentApplication->invalidate();
+    }
+    requestFrameBoost();
 }
 
 void SystemTask::loadApplication(Applications::Applications app) {
@@ -391,8 +502,11 @@ void SystemTask::loadApplication(Applications::Applications app) {
         break;
     }
     currentApp = app;
+    appUpdateElapsedMs = 0;
     xTimerStart(appTimer, 0);
+    requestFrameBoost();
     currentApplication->init();    
+    currentApplication->invalidate();
 
     //taskEXIT_CRITICAL();
 }
@@ -74,6 +74,10 @@ namespace System
         void loadApplication(Applications::Applications app);
         void pushMessage(SystemMSG msg, uint32_t value);
         void pushMessageKey(Keyboard::KeyCode key, Keyboard::KeyState state);
+        // Radio task events, as notification bits: no queue copy, and a
+        // burst of them costs the status task one wake
+        void notifyRadioRX(void) { notify(NOTIFY_RADIO_RX); }
+        void notifyRadioIdle(void) { notify(NOTIFY_RADIO_IDLE); }
         bool wasFKeyPressed() const { return keyboard.wasFKeyPressed(); };
         void setActionTimeout( uint16_t timeout ) {
             actionTimeout = timeout;
@@ -94,6 +98,11 @@ namespace System
         void setBacklightLevel(uint8_t level);
         bool isUARTBusy() const { return uartBusy; }
 
+        // For apps that animate or work through something on their own: the
+        // screen keeps the fast pace for the app timer ticks given. System
+        // task only, like the rest of the frame scheduler state.
+        void requestFrameBoost(uint8_t ticks = frameBoostTicks);
+
         // Static methods (required by FreeRTOS)
         static void runStatusTask(void* pvParameters);
         static void appTimerCallback(TimerHandle_t xTimer);
@@ -126,11 +135,27 @@ namespace System
         static constexpr uint8_t queueLenght = 20;
         static constexpr uint16_t itemSize = sizeof(SystemMessages);
 
+        // The task waits on its notification value, NOTIFY_MESSAGE is set
+        // when the queue got a message, NOTIFY_FRAME and NOTIFY_RUN_TIMER on
+        // each app and run timer tick, the others carry radio events
+        static constexpr uint32_t NOTIFY_MESSAGE = 1UL << 0;
+        static constexpr uint32_t NOTIFY_RADIO_RX = 1UL << 1;
+        static constexpr uint32_t NOTIFY_RADIO_IDLE = 1UL << 2;
+        static constexpr uint32_t NOTIFY_FRAME = 1UL << 3;
+        static constexpr uint32_t NOTIFY_RUN_TIMER = 1UL << 4;
+
+        void notify(uint32_t bits) {
+            if (systemTaskHandle) {
+                xTaskNotify(systemTaskHandle, bits, eSetBits);
+            }
+        }
+
+        TaskHandle_t systemTaskHandle = nullptr;
         QueueHandle_t systemMessageQueue; // Message queue handle
         StaticQueue_t systemTasksQueue; // Static queue storage area
         uint8_t systemQueueStorageArea[queueLenght * itemSize]; // Static queue storage area
 
-        TimerHandle_t appTimer;
+        TimerHandle_t appTimer = nullptr;
         StaticTimer_t appTimerBuffer;
         TimerHandle_t runTimer;
         StaticTimer_t runTimerBuffer;
@@ -161,6 +186,33 @@ namespace System
         uint8_t uartIdleCycles = 0;
         static constexpr uint8_t uartIdleCyclesToClear = 5;
 
+        // Frame scheduler: a frame is only drawn when the app invalidated the
+        // screen, at most one per app timer tick. The timer period follows
+        // the activity: fast while a key is held, the radio is on air or an
+        // app asked for a boost, slow when idle, and stopped while the
+        // backlight is off until a system message comes in. Apps update
+        // every 100 ms, or every tick when ticks are longer. The timer only
+        // wakes the system task, which updates and draws.
+        enum class FramePace : uint8_t {
+            FAST,
+            SLOW,
+            STOPPED
+        };
+
+        static constexpr uint16_t fastFramePeriodMs = 50;
+        static constexpr uint16_t slowFramePeriodMs = 1000;
+        static constexpr uint16_t appUpdatePeriodMs = 100;
+        static constexpr uint8_t frameBoostTicks = 1000 / fastFramePeriodMs;
+        FramePace framePace = FramePace::FAST;
+        uint8_t frameBoost = frameBoostTicks;
+        uint16_t appUpdateElapsedMs = 0;
+        UI::InfoMessageType shownInfoMessage = UI::InfoMessageType::INFO_NONE;
+        bool screenStreaming = false;
+
+        // UART1 is polled: wake at the short period only while it is busy
+        static constexpr uint8_t statusPollMs = 5;
+        static constexpr uint8_t statusIdlePollMs = 20;
+
         void initSystem(void);
         void showScreen(void);
         void statusTaskImpl(void);
@@ -169,6 +221,10 @@ namespace System
         void appTimerImpl(void);
         void runTimerImpl(void);
 
+        FramePace chooseFramePace(void);
+        void setFramePace(FramePace pace);
+        void refreshScreen(void);
+
     };
 
 }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "settings.h"
+#include "list_provider.h"
+
+// CTCSS and DCS labels, built at compile time from Settings::CTCSSOptions and
+// Settings::DCSOptions into flash. Each table holds the NUL terminated labels
+// back to back plus the offset of every one, so a label is one lookup away.
+namespace CodeLabels {
+
+    template <size_t Count, size_t Size>
+    struct Table {
+        char text[Size];
+        uint16_t offsets[Count];
+
+        constexpr const char* get(uint8_t index) const {
+            return &text[offsets[index < Count ? index : 0]];
+        }
+    };
+
+    // "67.0" to "254.1", the tone in 0.1 Hz
+    constexpr size_t ctcssLength(uint16_t tone) {
+        return tone >= 1000 ? 5 : 4;
+    }
+
+    // "D023" to "D754", the code in octal
+    constexpr size_t dcsLength(uint16_t) {
+        return 4;
+    }
+
+    // Every label plus its NUL
+    template <size_t Count>
+    constexpr size_t textSize(const uint16_t (&options)[Count], size_t (*length)(uint16_t)) {
+        size_t size = 0;
+        for (size_t i = 0; i < Count; i++) {
+            size += length(options[i]) + 1;
+        }
+        return size;
+    }
+
+    constexpr size_t CTCSS_COUNT = sizeof(Settings::CTCSSOptions) / sizeof(Settings::CTCSSOptions[0]);
+    constexpr size_t DCS_COUNT = sizeof(Settings::DCSOptions) / sizeof(Settings::DCSOptions[0]);
+    constexpr size_t CTCSS_SIZE = textSize(Settings::CTCSSOptions, ctcssLength);
+    constexpr size_t DCS_SIZE = textSize(Settings::DCSOptions, dcsLength);
+
+    consteval Table<CTCSS_COUNT, CTCSS_SIZE> makeCTCSS(void) {
+        Table<CTCSS_COUNT, CTCSS_SIZE> table{};
+        size_t pos = 0;
+        for (size_t i = 0; i < CTCSS_COUNT; i++) {
+            uint16_t tone = Settings::CTCSSOptions[i];
+            table.offsets[i] = (uint16_t)pos;
+            if (tone >= 1000) {
+                table.text[pos++] = (char)('0' + tone / 1000);
+            }
+            table.text[pos++] = (char)('0' + tone / 100 % 10);
+            table.text[pos++] = (char)('0' + tone / 10 % 10);
+            table.text[pos++] = '.';
+            table.text[pos++] = (char)('0' + tone % 10);
+            table.text[pos++] = '\0';
+        }
+        return table;
+    }
+
+    consteval Table<DCS_COUNT, DCS_SIZE> makeDCS(void) {
+        Table<DCS_COUNT, DCS_SIZE> table{};
+        size_t pos = 0;
+        for (size_t i = 0; i < DCS_COUNT; i++) {
+            uint16_t code = Settings::DCSOptions[i];
+            table.offsets[i] = (uint16_t)pos;
+            table.text[pos++] = 'D';
+            table.text[pos++] = (char)('0' + ((code >> 6) & 7));
+            table.text[pos++] = (char)('0' + ((code >> 3) & 7));
+            table.text[pos++] = (char)('0' + (code & 7));
+            table.text[pos++] = '\0';
+        }
+        return table;
+    }
+
+    inline constexpr auto CTCSS = makeCTCSS();
+    inline constexpr auto DCS = makeDCS();
+
+    // A table as SelectionList items, every row straight from its offset
+    template <size_t Count, size_t Size>
+    class Items : public ListProvider {
+    public:
+        constexpr Items(const Table<Count, Size>& table) : table{ table } {}
+
+        uint8_t getCount(void) const override {
+            return (uint8_t)Count;
+        }
+
+        const char* getItem(uint8_t index, char*) const override {
+            return index < Count ? table.get(index) : nullptr;
+        }
+
+    private:
+        const Table<Count, Size>& table;
+    };
+
+    inline constexpr Items CTCSSItems{ CTCSS };
+    inline constexpr Items DCSItems{ DCS };
+
+    static_assert(CTCSS.get(0)[0] == '6' && CTCSS.get(0)[3] == '0' && CTCSS.get(0)[4] == '\0');
+    static_assert(CTCSS.get(CTCSS_COUNT - 1)[0] == '2' && CTCSS.get(CTCSS_COUNT - 1)[4] == '1');
+    static_assert(DCS.get(0)[1] == '0' && DCS.get(0)[2] == '2' && DCS.get(0)[3] == '3');
+    static_assert(DCS.get(DCS_COUNT - 1)[1] == '7' && DCS.get(DCS_COUNT - 1)[4] == '\0');
+
+} // namespace CodeLabels
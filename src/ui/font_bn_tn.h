@@ -4,7 +4,7 @@
   Glyphs: 14/196
   BBX Build Mode: 0
 */
-const uint8_t u8g2_font_bn_tn[177] U8G2_FONT_SECTION("u8g2_font_bn_tn") = 
+constexpr uint8_t u8g2_font_bn_tn[177] U8G2_FONT_SECTION("u8g2_font_bn_tn") = 
   "\16\0\3\4\3\4\1\4\5\7\12\0\0\12\374\12\0\0\0\0\0\0\230+\13\307\211\65\70\311ip"
   "\22\0-\6\227\214\341\0.\6\223Ha\0\60\13\327\210S\242b/*%\0\61\11\327\210QT\70"
   "\237\34\62\14\327\210ar\70\205ep\320\1\63\15\327\210ar\70\305\342\340C\10\0\64\12\327\210\61"
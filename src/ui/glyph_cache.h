@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "u8g2.h"
+
+// A u8g2 font decoded at compile time into one bit column per glyph, the
+// way the ST7565 buffer holds pixels (bit 0 at the top). Drawing a string
+// is then a shift and a masked store per column instead of walking the
+// RLE bitstream of every glyph on every frame.
+//
+//     static constexpr auto bigDigits = GlyphCache::decode<u8g2_font_bn_tn[9], '+', ':'>(u8g2_font_bn_tn);
+//     bigDigits.draw(lcd()->getU8g2(), x, y, "145.500");
+//
+// Glyphs between First and Last are kept, up to 16 pixels high and MaxWidth
+// (the font's max char width, header byte 9) wide. The result matches
+// u8g2_DrawStr with the font in solid mode, baseline reference and no
+// rotation, which is how the UI draws.
+namespace GlyphCache {
+
+    template <uint8_t MaxWidth>
+    struct Glyph {
+        bool present;
+        uint8_t width;
+        uint8_t height;
+        int8_t x;           // offset from the pen position
+        int8_t y;           // bottom row above the baseline
+        int8_t dx;          // pen advance
+        uint16_t columns[MaxWidth];
+    };
+
+    template <uint8_t MaxWidth, char First, char Last>
+    class Font {
+    public:
+        static constexpr uint8_t COUNT = (uint8_t)(Last - First + 1);
+
+        Glyph<MaxWidth> glyphs[COUNT];
+        int8_t ascent;
+
+        constexpr const Glyph<MaxWidth>* find(char c) const {
+            if (c < First || c > Last || !glyphs[c - First].present) {
+                return nullptr;
+            }
+            return &glyphs[c - First];
+        }
+
+        // u8g2_GetStrWidth, balanced as U8G2_BALANCED_STR_WIDTH_CALCULATION
+        // builds it
+        constexpr uint16_t width(const char* str) const {
+            int16_t w = 0;
+            int8_t dx = 0;
+            int8_t initialX = -64;
+            const Glyph<MaxWidth>* last = nullptr;
+            for (; *str; str++) {
+                const Glyph<MaxWidth>* glyph = find(*str);
+                if (!glyph) {
+                    dx = 0;
+                    continue;
+                }
+                if (initialX == -64) {
+                    initialX = glyph->x;
+                }
+                dx = glyph->dx;
+                w = (int16_t)(w + dx);
+                last = glyph;
+            }
+            if (last && last->width) {
+                w = (int16_t)(w - dx + last->width + last->x);
+                if (initialX > 0) {
+                    w = (int16_t)(w + initialX);
+                }
+            }
+            return (uint16_t)w;
+        }
+
+        // Draws str with its baseline at y in the current draw color (0 or 1),
+        // the rest of each glyph box in the other. Clipped to the pages the
+        // buffer holds in this pass. Returns the advance, as u8g2_DrawStr.
+        uint16_t draw(u8g2_t* u8g2, uint16_t x, uint16_t y, const char* str) const {
+            uint8_t* buffer = u8g2_GetBufferPtr(u8g2);
+            int16_t bufferWidth = (int16_t)u8g2->pixel_buf_width;
+            int16_t firstRow = (int16_t)u8g2->pixel_curr_row;
+            int16_t rows = (int16_t)(u8g2_GetBufferTileHeight(u8g2) * 8);
+            bool solid = u8g2->draw_color != 0;
+            uint16_t start = x;
+
+            for (; *str; str++) {
+                const Glyph<MaxWidth>* glyph = find(*str);
+                if (!glyph) {
+                    continue;
+                }
+                if (glyph->width) {
+                    // Glyph top relative to the buffer, 0 is its first row
+                    int16_t top = (int16_t)(y - (glyph->height + glyph->y) - firstRow);
+                    if (top < rows && top + glyph->height > 0) {
+                        uint32_t box = (1U << glyph->height) - 1U;
+                        int16_t left = (int16_t)(x + glyph->x);
+                        for (uint8_t col = 0; col < glyph->width; col++) {
+                            int16_t px = (int16_t)(left + col);
+                            if (px < 0 || px >= bufferWidth) {
+                                continue;
+                            }
+                            uint32_t bits = solid ? glyph->columns[col] : ~glyph->columns[col] & box;
+                            uint32_t mask = box;
+                            int16_t page = 0;
+                            if (top >= 0) {
+                                bits <<= top & 7;
+                                mask <<= top & 7;
+                                page = (int16_t)(top >> 3);
+                            }
+                            else {
+                                bits >>= -top;
+                                mask >>= -top;
+                            }
+                            uint8_t* dst = buffer + page * bufferWidth + px;
+                            for (; mask && page < rows / 8; page++, dst += bufferWidth) {
+                                *dst = (uint8_t)((*dst & ~mask) | (bits & mask));
+                                bits >>= 8;
+                                mask >>= 8;
+                            }
+                        }
+                    }
+                }
+                x = (uint16_t)(x + glyph->dx);
+            }
+            return (uint16_t)(x - start);
+        }
+    };
+
+    // The bit reader of u8g2_font_decode_get_unsigned_bits, LSB first
+    template <size_t Size>
+    struct BitReader {
+        const uint8_t (&data)[Size];
+        size_t pos;
+        uint8_t bit = 0;
+
+        constexpr uint8_t get(uint8_t count) {
+            uint16_t value = (uint16_t)(data[pos] >> bit);
+            uint8_t end = (uint8_t)(bit + count);
+            if (end >= 8) {
+                pos++;
+                if (pos < Size) {
+                    value = (uint16_t)(value | data[pos] << (8 - bit));
+                }
+                end = (uint8_t)(end - 8);
+            }
+            bit = end;
+            return (uint8_t)(value & ((1U << count) - 1));
+        }
+
+        constexpr int8_t getSigned(uint8_t count) {
+            return (int8_t)(get(count) - (1 << (count - 1)));
+        }
+    };
+
+    // Not constexpr: reaching it stops decode() from compiling
+    void glyphTooLarge(void);
+
+    template <uint8_t MaxWidth, char First, char Last, size_t Size>
+    consteval Font<MaxWidth, First, Last> decode(const uint8_t (&font)[Size]) {
+        // Font header, see u8g2_read_font_info
+        constexpr size_t HEADER_SIZE = 23;
+        uint8_t bitsPer0 = font[2];
+        uint8_t bitsPer1 = font[3];
+        uint8_t bitsPerWidth = font[4];
+        uint8_t bitsPerHeight = font[5];
+        uint8_t bitsPerX = font[6];
+        uint8_t bitsPerY = font[7];
+        uint8_t bitsPerDx = font[8];
+
+        Font<MaxWidth, First, Last> result{};
+        result.ascent = (int8_t)font[13];
+
+        // Glyphs with 8 bit encodings: [encoding][size][bitstream], 0 ends
+        for (size_t at = HEADER_SIZE; at + 1 < Size && font[at] != 0; at += font[at + 1]) {
+            char encoding = (char)font[at];
+            if (encoding < First || encoding > Last) {
+                continue;
+            }
+            Glyph<MaxWidth>& glyph = result.glyphs[encoding - First];
+            BitReader<Size> reader{ font, at + 2 };
+            glyph.present = true;
+            glyph.width = reader.get(bitsPerWidth);
+            glyph.height = reader.get(bitsPerHeight);
+            glyph.x = reader.getSigned(bitsPerX);
+            glyph.y = reader.getSigned(bitsPerY);
+            glyph.dx = reader.getSigned(bitsPerDx);
+            if (glyph.width > MaxWidth || glyph.height > 16) {
+                glyphTooLarge();
+            }
+            if (glyph.width == 0) {
+                continue;
+            }
+
+            // Runs of background then foreground pixels, row by row, a 1 bit
+            // repeats the last pair (u8g2_font_decode_glyph)
+            uint8_t px = 0;
+            uint8_t py = 0;
+            auto run = [&](uint8_t length, bool foreground) {
+                for (; length; length--) {
+                    if (foreground && py < glyph.height) {
+                        glyph.columns[px] = (uint16_t)(glyph.columns[px] | 1U << py);
+                    }
+                    if (++px == glyph.width) {
+                        px = 0;
+                        py++;
+                    }
+                }
+            };
+            while (py < glyph.height) {
+                uint8_t zeros = reader.get(bitsPer0);
+                uint8_t ones = reader.get(bitsPer1);
+                do {
+                    run(zeros, false);
+                    run(ones, true);
+                } while (reader.get(1) != 0);
+            }
+        }
+        return result;
+    }
+
+} // namespace GlyphCache
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include "u8g2.h"
+
+// Source of the lines a SelectionList shows. Drawing only fetches the rows
+// in view, so a list can be as long as its provider can index.
+//
+// getItem returns the line, ending at '\n' or NUL. Text the provider already
+// holds is returned as is; anything it builds goes into buf, ITEM_SIZE chars
+// the caller passes in.
+class ListProvider {
+public:
+    static constexpr uint8_t ITEM_SIZE = 20;
+
+    virtual uint8_t getCount(void) const = 0;
+    virtual const char* getItem(uint8_t index, char* buf) const = 0;
+};
+
+// A '\n' separated list, for the short fixed menus. Lines are found by
+// scanning from the start.
+class StringListProvider : public ListProvider {
+public:
+    constexpr StringListProvider(const char* lines = "") : lines{ lines } {}
+
+    uint8_t getCount(void) const override {
+        return u8x8_GetStringLineCnt(lines);
+    }
+
+    const char* getItem(uint8_t index, char*) const override {
+        return u8x8_GetStringLineStart(index, lines);
+    }
+
+private:
+    const char* lines;
+};
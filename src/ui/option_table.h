@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "list_provider.h"
+
+// A '\n' separated literal, held so it can be a template argument
+template <size_t Size>
+struct OptionString {
+    char text[Size];
+
+    consteval OptionString(const char (&str)[Size]) {
+        for (size_t i = 0; i < Size; i++) {
+            text[i] = str[i];
+        }
+    }
+};
+
+// Setting options from one '\n' separated literal, split at compile time
+// into NUL terminated strings in flash with the offset and length of each.
+// An option is one index away and prints with a plain "%s".
+//
+//     static constexpr OptionTable<"OFF\nON"> onoffStr{};
+//     onoffStr.get(1);    // "ON"
+template <OptionString Text>
+class OptionTable : public ListProvider {
+public:
+    static constexpr uint8_t COUNT = [] {
+        uint8_t count = 1;
+        for (char c : Text.text) {
+            count = (uint8_t)(count + (c == '\n'));
+        }
+        return count;
+    }();
+
+    // The option, "" when index is out of range
+    constexpr const char* get(uint8_t index) const {
+        return index < COUNT ? &table.text[table.offset[index]] : &table.text[sizeof(Text.text) - 1];
+    }
+
+    constexpr uint8_t length(uint8_t index) const {
+        return index < COUNT ? table.length[index] : 0;
+    }
+
+    uint8_t getCount(void) const override {
+        return COUNT;
+    }
+
+    const char* getItem(uint8_t index, char*) const override {
+        return index < COUNT ? get(index) : nullptr;
+    }
+
+private:
+    struct Table {
+        char text[sizeof(Text.text)];
+        uint8_t offset[COUNT];
+        uint8_t length[COUNT];
+    };
+
+    static_assert(sizeof(Text.text) <= 256, "option offsets are 8 bit");
+
+    static constexpr Table table = [] {
+        Table t{};
+        uint8_t option = 0;
+        uint8_t start = 0;
+        for (size_t i = 0; i < sizeof(Text.text); i++) {
+            char c = Text.text[i];
+            if (c == '\n' || c == '\0') {
+                t.offset[option] = start;
+                t.length[option] = (uint8_t)(i - start);
+                option++;
+                start = (uint8_t)(i + 1);
+                c = '\0';
+            }
+            t.text[i] = c;
+        }
+        return t;
+    }();
+};
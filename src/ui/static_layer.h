@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include "u8g2.h"
+
+// The part of an app screen that stays the same from frame to frame (bars,
+// scales, frames) kept as the buffer bytes it drew, so later frames copy
+// them instead of running the u8g2 primitives again.
+//
+//     if (!staticLayer.draw(u8g2)) {
+//         // header bars, meter scale...
+//         staticLayer.capture(u8g2);
+//     }
+//     // everything else, on top
+//
+// Both work on the pages the buffer holds in this pass, a page is captured
+// the first time a frame draws it. The static elements go first, on the
+// cleared buffer, since capture() takes whatever is set there. Column runs
+// of one byte value are stored as that byte, short gaps as zero bytes.
+// When the layer does not fit it stays empty and the app keeps drawing
+// those elements itself.
+template <uint8_t MaxSpans, uint16_t MaxBytes>
+class StaticLayer {
+public:
+    // The app changed what its static elements look like
+    void invalidate(void) {
+        validPages = 0;
+        spanCount = 0;
+        byteCount = 0;
+        full = false;
+    }
+
+    // Puts the layer in the buffer, false when a page of this pass was not
+    // captured yet
+    bool draw(u8g2_t* u8g2) const {
+        uint8_t firstPage = (uint8_t)(u8g2->tile_curr_row);
+        uint8_t passPages = passMask(u8g2);
+        if ((validPages & passPages) != passPages) {
+            return false;
+        }
+
+        uint8_t* buffer = u8g2_GetBufferPtr(u8g2);
+        uint16_t width = u8g2->pixel_buf_width;
+        for (uint8_t i = 0; i < spanCount; i++) {
+            const Span& span = spans[i];
+            if (!(passPages & (1U << span.page))) {
+                continue;
+            }
+            uint8_t* dst = buffer + (span.page - firstPage) * width + span.x;
+            if (span.uniform) {
+                uint8_t value = bytes[span.offset];
+                for (uint8_t x = 0; x < span.width; x++) {
+                    dst[x] |= value;
+                }
+            }
+            else {
+                const uint8_t* src = &bytes[span.offset];
+                for (uint8_t x = 0; x < span.width; x++) {
+                    dst[x] |= src[x];
+                }
+            }
+        }
+        return true;
+    }
+
+    // Stores what is drawn in the pages of this pass
+    void capture(u8g2_t* u8g2) {
+        uint8_t passPages = passMask(u8g2);
+        if (full || (validPages & passPages) == passPages) {
+            return;
+        }
+
+        uint8_t firstPage = (uint8_t)(u8g2->tile_curr_row);
+        uint8_t pages = u8g2_GetBufferTileHeight(u8g2);
+        uint16_t width = u8g2->pixel_buf_width;
+        const uint8_t* page = u8g2_GetBufferPtr(u8g2);
+        uint8_t spansBefore = spanCount;
+        uint16_t bytesBefore = byteCount;
+
+        for (uint8_t p = 0; p < pages; p++, page += width) {
+            uint16_t x = 0;
+            while (x < width) {
+                if (page[x] == 0) {
+                    x++;
+                    continue;
+                }
+                // A gap shorter than a span is cheaper kept as zero bytes
+                uint16_t end = (uint16_t)(x + 1);
+                for (uint16_t next = end; next < width && next - end < (int)sizeof(Span); next++) {
+                    if (page[next] != 0) {
+                        end = (uint16_t)(next + 1);
+                    }
+                }
+                bool uniform = true;
+                for (uint16_t i = x; i < end; i++) {
+                    uniform = uniform && page[i] == page[x];
+                }
+                if (!addSpan((uint8_t)(firstPage + p), (uint8_t)x, (uint8_t)(end - x), uniform, &page[x])) {
+                    // Too much for the layer: drop this pass and stop trying
+                    // until the next invalidate()
+                    spanCount = spansBefore;
+                    byteCount = bytesBefore;
+                    full = true;
+                    return;
+                }
+                x = end;
+            }
+        }
+        validPages = (uint8_t)(validPages | passPages);
+    }
+
+private:
+    struct Span {
+        uint8_t page;
+        uint8_t x;
+        uint8_t width;
+        bool uniform;       // one byte for the whole run
+        uint16_t offset;    // in bytes
+    };
+
+    Span spans[MaxSpans];
+    uint8_t bytes[MaxBytes];
+    uint8_t spanCount = 0;
+    uint16_t byteCount = 0;
+    uint8_t validPages = 0;
+    bool full = false;
+
+    static uint8_t passMask(u8g2_t* u8g2) {
+        uint8_t pages = u8g2_GetBufferTileHeight(u8g2);
+        return (uint8_t)(((1U << pages) - 1U) << u8g2->tile_curr_row);
+    }
+
+    bool addSpan(uint8_t page, uint8_t x, uint8_t width, bool uniform, const uint8_t* data) {
+        uint8_t size = uniform ? 1 : width;
+        if (spanCount >= MaxSpans || byteCount + size > MaxBytes) {
+            return false;
+        }
+        spans[spanCount++] = { page, x, width, uniform, byteCount };
+        for (uint8_t i = 0; i < size; i++) {
+            bytes[byteCount++] = data[i];
+        }
+        return true;
+    }
+};
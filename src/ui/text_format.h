@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Typed text formatting for the screen. Each value says how it is printed
+// through its type, so the layout is fixed when the call compiles: there is
+// no format string to parse and no va_list.
+//
+//     Fmt::Text<12> t(Fmt::zero<2>(pos), " / ", Fmt::zero<2>(total));  // "03 / 17"
+//     ui.drawString(..., t);
+//     Fmt::format(buffer, sizeof(buffer), "CH-", Fmt::zero<3>(channel));
+//
+// Nothing is written past the buffer, whatever does not fit is dropped.
+namespace Fmt {
+
+    // Unsigned decimal, at least Width digits padded with Pad ("%02u", "%3u")
+    template <uint8_t Width, char Pad>
+    struct Dec {
+        uint32_t value;
+    };
+
+    // Signed decimal ("%i")
+    struct Int {
+        int32_t value;
+    };
+
+    // value / 10^Decimals with exactly Decimals digits after the point ("%u.%02u")
+    template <uint8_t Decimals>
+    struct Fixed {
+        uint32_t value;
+    };
+
+    // Octal, at least Width digits padded with '0' ("%03o")
+    template <uint8_t Width>
+    struct Oct {
+        uint32_t value;
+    };
+
+    // Signed decimal with a percent sign ("%i%%")
+    struct Percent {
+        int32_t value;
+    };
+
+    // One line of a '\n' separated list, up to the '\n' ("%.*s")
+    struct Line {
+        const char* str;
+    };
+
+    constexpr Dec<0, '0'> dec(uint32_t value) { return { value }; }
+
+    template <uint8_t Width>
+    constexpr Dec<Width, '0'> zero(uint32_t value) { return { value }; }
+
+    template <uint8_t Width>
+    constexpr Dec<Width, ' '> pad(uint32_t value) { return { value }; }
+
+    constexpr Int sdec(int32_t value) { return { value }; }
+
+    template <uint8_t Decimals>
+    constexpr Fixed<Decimals> fixed(uint32_t value) { return { value }; }
+
+    template <uint8_t Width>
+    constexpr Oct<Width> oct(uint32_t value) { return { value }; }
+
+    constexpr Percent percent(int32_t value) { return { value }; }
+
+    constexpr Line line(const char* str) { return { str }; }
+
+    // Appends the parts to a caller's buffer, always NUL terminated
+    class Writer {
+    public:
+        Writer(char* buffer, size_t size) : buffer{ buffer }, last{ (uint8_t)(size > 255 ? 254 : size - 1) } {}
+
+        template <typename... Parts>
+        uint8_t write(const Parts&... parts) {
+            (put(parts), ...);
+            buffer[length] = '\0';
+            return length;
+        }
+
+    private:
+        char* buffer;
+        uint8_t last;
+        uint8_t length = 0;
+
+        void put(char c) {
+            if (length < last) {
+                buffer[length++] = c;
+            }
+        }
+
+        void put(const char* str) {
+            while (*str && length < last) {
+                buffer[length++] = *str++;
+            }
+        }
+
+        void put(Line part) {
+            const char* str = part.str;
+            while (*str && *str != '\n' && length < last) {
+                buffer[length++] = *str++;
+            }
+        }
+
+        // Digits of value in base, at least width of them
+        void putNumber(uint32_t value, uint8_t base, uint8_t width, char padChar) {
+            char digits[11];
+            uint8_t count = 0;
+            do {
+                digits[count++] = (char)('0' + value % base);
+                value /= base;
+            } while (value);
+            while (width > count) {
+                put(padChar);
+                width--;
+            }
+            while (count) {
+                put(digits[--count]);
+            }
+        }
+
+        void putSigned(int32_t value) {
+            if (value < 0) {
+                put('-');
+                putNumber(0U - (uint32_t)value, 10, 0, '0');
+            }
+            else {
+                putNumber((uint32_t)value, 10, 0, '0');
+            }
+        }
+
+        template <uint8_t Width, char Pad>
+        void put(Dec<Width, Pad> part) {
+            putNumber(part.value, 10, Width, Pad);
+        }
+
+        void put(Int part) {
+            putSigned(part.value);
+        }
+
+        template <uint8_t Decimals>
+        void put(Fixed<Decimals> part) {
+            static_assert(Decimals > 0 && Decimals < 10, "Fixed takes 1 to 9 decimals");
+            constexpr uint32_t scale = [] {
+                uint32_t s = 1;
+                for (uint8_t i = 0; i < Decimals; i++) {
+                    s *= 10;
+                }
+                return s;
+            }();
+            putNumber(part.value / scale, 10, 0, '0');
+            put('.');
+            putNumber(part.value % scale, 10, Decimals, '0');
+        }
+
+        template <uint8_t Width>
+        void put(Oct<Width> part) {
+            putNumber(part.value, 8, Width, '0');
+        }
+
+        void put(Percent part) {
+            putSigned(part.value);
+            put('%');
+        }
+    };
+
+    template <typename... Parts>
+    uint8_t format(char* buffer, size_t size, const Parts&... parts) {
+        return Writer(buffer, size).write(parts...);
+    }
+
+    // The parts in a buffer of its own, for passing straight to a draw call
+    template <size_t Size>
+    class Text {
+    public:
+        static_assert(Size > 1 && Size <= 255, "Text holds up to 254 chars");
+
+        template <typename... Parts>
+        explicit Text(const Parts&... parts) {
+            length = format(text, Size, parts...);
+        }
+
+        const char* c_str(void) const {
+            return text;
+        }
+
+        operator const char* (void) const {
+            return text;
+        }
+
+        uint8_t size(void) const {
+            return length;
+        }
+
+    private:
+        char text[Size];
+        uint8_t length;
+    };
+
+} // namespace Fmt
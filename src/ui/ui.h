@@ -7,6 +7,9 @@
 #include "sys.h"
 #include "uart_hal.h"
 #include "keyboard.h"
+#include "list_provider.h"
+#include "text_format.h"
+#include "glyph_cache.h"
 
 #include "icons.h"
 
@@ -36,7 +39,10 @@ enum class Font {
 #define W 128
 #define H 64
 
-static constexpr uint16_t CHAR_BUFFER_SIZE = 600;
+// Formatted values, the longest is a frequency in "%u.%03u KHz"
+static constexpr uint16_t CHAR_BUFFER_SIZE = 24;
+// Longest line drawText builds, more than a row of the 5 px font
+static constexpr uint8_t TEXT_SIZE = 32;
 static char uiBuffer[CHAR_BUFFER_SIZE];
 
 class UI {
@@ -56,7 +62,7 @@ public:
 
     uint8_t menu_pos = 1;
 
-    static constexpr const char* InfoMessageStr = "BATTERY LOW\nTX DISABLED\nUART IN USE";
+    static constexpr OptionTable<"BATTERY LOW\nTX DISABLED\nUART IN USE"> InfoMessageStr{};
 
     enum class InfoMessageType : uint8_t {
         INFO_NONE = 0,
@@ -65,22 +71,20 @@ public:
         UART_COMM = 3
     };
 
-    void clearDisplay() {
-        //lcd()->setColorIndex(WHITE);
-        //lcd()->drawBox(0, 0, W, H);
-        //lcd()->sendBuffer();
-        lcd()->clearBuffer();
+    // Frame loop, see ST7565::beginFrame(). A screen stream gets every page
+    bool beginFrame(uint8_t pages) {
+        return lcd()->beginFrame(uart.isScreenStreaming() ? 0xFF : pages);
     }
 
-    void updateDisplay() {
+    bool nextPage() {
         // show popup info message
         if (infoMessage != InfoMessageType::INFO_NONE) {
             drawPopupWindow(20, 20, 88, 24, "Info");
             setFont(Font::FONT_8B_TR);
-            drawString(TextAlign::CENTER, 22, 106, 38, true, false, false, getStrValue(InfoMessageStr, (uint8_t)infoMessage - 1));            
+            drawString(TextAlign::CENTER, 22, 106, 38, true, false, false, InfoMessageStr.get((uint8_t)infoMessage - 1));            
         }
-        lcd()->sendBuffer();
-        uart.sendScreenBuffer(lcd()->getBufferPtr(), 1024);
+        uart.sendScreenBuffer(lcd()->getBufferPtr(), ST7565::BUFFER_PAGES * W, lcd()->getBufferRow() == 0);
+        return lcd()->nextFramePage();
     }
 
     void timeOut() {
@@ -130,22 +134,17 @@ public:
         lcd()->setColorIndex(WHITE);
     }
 
-    void drawStrf(u8g2_uint_t x, u8g2_uint_t y, const char* str, ...) {
-        char text[40] = { 0 };
-
-        va_list va;
-        va_start(va, str);
-        vsnprintf(text, sizeof(text), str, va);
-        va_end(va);
-
-        lcd()->drawStr(x, y, text);
+    void drawString(TextAlign tAlign, u8g2_uint_t xstart, u8g2_uint_t xend, u8g2_uint_t y, bool isBlack, bool isFill, bool isBox, const char* str) {
+        u8g2_uint_t startX = drawStringBox(tAlign, xstart, xend, y, isBlack, isFill, isBox, lcd()->getStrWidth(str), (u8g2_uint_t)(lcd()->getAscent()));
+        lcd()->drawStr(startX, y, str);
     }
 
-    void drawString(TextAlign tAlign, u8g2_uint_t xstart, u8g2_uint_t xend, u8g2_uint_t y, bool isBlack, bool isFill, bool isBox, const char* str) {
+    // Fill or frame of drawString for text stringWidth wide and h high, leaves
+    // the text color set and returns where the text starts
+    u8g2_uint_t drawStringBox(TextAlign tAlign, u8g2_uint_t xstart, u8g2_uint_t xend, u8g2_uint_t y, bool isBlack, bool isFill, bool isBox, u8g2_uint_t stringWidth, u8g2_uint_t h) {
 
         u8g2_uint_t startX = xstart;
         u8g2_uint_t endX = xend;
-        u8g2_uint_t stringWidth = lcd()->getStrWidth(str);
 
         u8g2_uint_t xx, yy, ww, hh;
 
@@ -160,8 +159,6 @@ public:
         //int8_t a = lcd()->getAscent();
         //int8_t d = lcd()->getDescent();
 
-        u8g2_uint_t h = (u8g2_uint_t)(lcd()->getAscent());//lcd()->getMaxCharHeight() + lcd()->getDescent();
-
         if (endX > startX) {
             if (tAlign == TextAlign::CENTER) {
                 if (stringWidth < (endX - startX)) {
@@ -207,8 +204,7 @@ public:
             lcd()->drawFrame(xx, yy, ww, hh);
         }
 
-        lcd()->drawStr(startX, y, str);
-
+        return startX;
     }
 
     // display a string on multiple text lines, keeping words intact where possible,
@@ -243,15 +239,10 @@ public:
         }
     }
 
-    void drawStringf(TextAlign tAlign, u8g2_uint_t xstart, u8g2_uint_t xend, u8g2_uint_t y, bool isBlack, bool isFill, bool isBox, const char* str, ...) {
-        char text[60] = { 0 };
-
-        va_list va;
-        va_start(va, str);
-        vsnprintf(text, sizeof(text), str, va);
-        va_end(va);
-
-        drawString(tAlign, xstart, xend, y, isBlack, isFill, isBox, text);
+    // drawString of the parts joined with Fmt::Text, see text_format.h
+    template <typename... Parts>
+    void drawText(TextAlign tAlign, u8g2_uint_t xstart, u8g2_uint_t xend, u8g2_uint_t y, bool isBlack, bool isFill, bool isBox, const Parts&... parts) {
+        drawString(tAlign, xstart, xend, y, isBlack, isFill, isBox, Fmt::Text<TEXT_SIZE>(parts...));
     }
 
     const char* getStrValue(const char* str, uint8_t index) {
@@ -305,36 +296,36 @@ public:
 
     /* - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
+    // The digits come from bigDigits, decoded when the firmware is built,
+    // the "%02u" tail in the 10 px font
     void drawFrequencyBig(bool invert, uint32_t freq, u8g2_uint_t xend, u8g2_uint_t y) {
 
-        setFont(Font::FONT_BN_TN);
-
         if (freq >= 100000000) {
-            drawStringf(TextAlign::RIGHT, 0, xend, y, true, invert, false, "%1u.%03u.%03u", (freq / 100000000), (freq / 100000) % 1000, (freq % 100000) / 100);
+            drawBigDigits(xend, y, invert, Fmt::Text<TEXT_SIZE>(Fmt::dec(freq / 100000000), '.', Fmt::zero<3>((freq / 100000) % 1000), '.', Fmt::zero<3>((freq % 100000) / 100)));
         }
         else if (freq >= 10000000) {
-            drawStringf(TextAlign::RIGHT, 0, xend, y, true, invert, false, "%3u.%03u", (freq / 100000), (freq % 100000) / 100);
+            drawBigDigits(xend, y, invert, Fmt::Text<TEXT_SIZE>(Fmt::pad<3>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100)));
         }
         else {
-            drawStringf(TextAlign::RIGHT, 0, xend, y, true, invert, false, "%2u.%03u", (freq / 100000), (freq % 100000) / 100);
+            drawBigDigits(xend, y, invert, Fmt::Text<TEXT_SIZE>(Fmt::pad<2>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100)));
         }
         setBlackColor();
 
         setFont(Font::FONT_10_TR);
-        drawStringf(TextAlign::LEFT, xend + 2, 0, y, true, invert, false, "%02u", (freq % 100));
+        drawText(TextAlign::LEFT, xend + 2, 0, y, true, invert, false, Fmt::zero<2>(freq % 100));
     }
 
     void drawFrequencySmall(bool invert, uint32_t freq, u8g2_uint_t xend, u8g2_uint_t y) {
 
         setFont(Font::FONT_10_TR);
         if (freq >= 100000000) {
-            drawStringf(TextAlign::RIGHT, 0, xend, y, true, invert, false, "%1u.%03u.%03u.%02u", (freq / 100000000), (freq / 100000) % 1000, (freq % 100000) / 100, (freq % 100));
+            drawText(TextAlign::RIGHT, 0, xend, y, true, invert, false, Fmt::dec(freq / 100000000), '.', Fmt::zero<3>((freq / 100000) % 1000), '.', Fmt::zero<3>((freq % 100000) / 100), '.', Fmt::zero<2>(freq % 100));
         }
         else if (freq >= 10000000) {
-            drawStringf(TextAlign::RIGHT, 0, xend, y, true, invert, false, "%3u.%03u.%02u", (freq / 100000), (freq % 100000) / 100, (freq % 100));
+            drawText(TextAlign::RIGHT, 0, xend, y, true, invert, false, Fmt::pad<3>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100), '.', Fmt::zero<2>(freq % 100));
         }
         else {
-            drawStringf(TextAlign::RIGHT, 0, xend, y, true, invert, false, "%2u.%03u.%02u", (freq / 100000), (freq % 100000) / 100, (freq % 100));
+            drawText(TextAlign::RIGHT, 0, xend, y, true, invert, false, Fmt::pad<2>(freq / 100000), '.', Fmt::zero<3>((freq % 100000) / 100), '.', Fmt::zero<2>(freq % 100));
         }
     }
 
@@ -365,8 +356,8 @@ public:
         return pixels;
     }
 
+    // The S level blocks, over the scale draw_smeter draws at x, y
     void drawRSSI(uint8_t sLevel, /*uint16_t plusDB, */u8g2_uint_t x, u8g2_uint_t y) {
-        draw_smeter(x, y, BLACK);
         setBlackColor();
 
         // Draw S1 to S9 blocks
@@ -395,65 +386,28 @@ public:
         lcd()->drawBox(x + 1, y + 1, fill, 3);
     }
 
-    const char* generateCTDCList(const uint16_t* options, size_t count, bool isCTCSS = true) {
-        char* ptr = uiBuffer;
-        size_t  remaining = CHAR_BUFFER_SIZE;
-        int written;
-
-        uiBuffer[0] = '\0';
-
-        for (size_t i = 0; i < count; i++) {
-
-            if (isCTCSS) {
-                written = snprintf(ptr, remaining, "%u.%u%s", options[i] / 10, options[i] % 10, (i == count - 1) ? "" : "\n");
-            }
-            else {
-                written = snprintf(ptr, remaining, "D%03o%s", options[i], (i == count - 1) ? "" : "\n");
-            }
-
-            if (written < 0 || (size_t)written >= remaining) {
-                break;
-            }
-
-            ptr += written;
-            remaining -= written;
-        }
-
-        return uiBuffer;
-    }
-
     const char* getFrequencyString(uint32_t frequency, uint8_t precision = 0, bool isKHz = false) {
        // Format the frequency string based on the precision and whether it's in kHz
-        if (isKHz) {
-            if (precision == 0) {
-                snprintf(uiBuffer, CHAR_BUFFER_SIZE, "%u.%03u KHz",
-                         static_cast<unsigned int>(frequency / 1000),
-                         static_cast<unsigned int>((frequency % 1000) / 10));
-            } else {
-                snprintf(uiBuffer, CHAR_BUFFER_SIZE, "%u.%03u KHz",
-                         static_cast<unsigned int>(frequency / 1000),
-                         static_cast<unsigned int>(frequency % 1000));
-            }
-        } else {
-            if (precision == 0) {
-                snprintf(uiBuffer, CHAR_BUFFER_SIZE, "%u.%03u Hz",
-                         static_cast<unsigned int>(frequency / 1000),
-                         static_cast<unsigned int>((frequency % 1000) / 10));
-            } else {
-                snprintf(uiBuffer, CHAR_BUFFER_SIZE, "%u.%03u Hz",
-                         static_cast<unsigned int>(frequency / 1000),
-                         static_cast<unsigned int>(frequency % 1000));
-            }
-        }
+        uint32_t fraction = precision == 0 ? (frequency % 1000) / 10 : frequency % 1000;
+        Fmt::format(uiBuffer, CHAR_BUFFER_SIZE, Fmt::dec(frequency / 1000), '.', Fmt::zero<3>(fraction), isKHz ? " KHz" : " Hz");
         return uiBuffer;
     }
 
 private:
 
+    // u8g2_font_bn_tn, '+' to ':'
+    static constexpr auto bigDigits = GlyphCache::decode<u8g2_font_bn_tn[9], '+', ':'>(u8g2_font_bn_tn);
+
     ST7565& st7565;
     UART& uart;
 
     bool onlyUpperCase = false;
+
+    // drawString(RIGHT, 0, xend, y, true, isFill, false, text) in FONT_BN_TN
+    void drawBigDigits(u8g2_uint_t xend, u8g2_uint_t y, bool isFill, const char* text) {
+        u8g2_uint_t startX = drawStringBox(TextAlign::RIGHT, 0, xend, y, true, isFill, false, bigDigits.width(text), (u8g2_uint_t)bigDigits.ascent);
+        bigDigits.draw(lcd()->getU8g2(), startX, y, text);
+    }
     InfoMessageType infoMessage = InfoMessageType::INFO_NONE;
 
 };
@@ -500,10 +454,15 @@ public:
     }
 
     void set(uint8_t startPos, uint8_t displayLines, uint8_t maxw, const char* sl, const char* sf = NULL) {
+        stringItems = StringListProvider(sl);
+        set(startPos, displayLines, maxw, stringItems, sf);
+    }
+
+    void set(uint8_t startPos, uint8_t displayLines, uint8_t maxw, const ListProvider& list, const char* sf = NULL) {
 
         u8sl.visible = displayLines;
 
-        u8sl.total = u8x8_GetStringLineCnt(sl);
+        u8sl.total = list.getCount();
         if (u8sl.total <= u8sl.visible)
             u8sl.visible = u8sl.total;
 
@@ -531,7 +490,7 @@ public:
             u8sl.current_pos = u8sl.total - 1;
         }
 
-        slines = sl;
+        items = &list;
         suffix = sf;
         maxWidth = maxw;
     }
@@ -568,7 +527,7 @@ public:
 
     void draw(uint8_t y, const char* info = NULL) {
         ui.lcd()->setFontPosBaseline();
-        drawSelectionList(y, slines, info);
+        drawSelectionList(y, info);
     }
 
     void setStartXPos(uint8_t x) {
@@ -583,25 +542,23 @@ public:
         showLineNumbers = show;
     }
 
-    const char* getStringLine() {
-        return u8x8_GetStringLineStart(u8sl.current_pos, slines);
-    }
-
     void setSuffix(const char* sf) {
         suffix = sf;
     }
 
 private:
     u8sl_t u8sl;
-    const char* slines;
+    StringListProvider stringItems;
+    const ListProvider* items = &stringItems;
     const char* suffix;
     uint8_t maxWidth = 75;
     uint8_t startXPos = 2;
     bool showLineNumbers = true;
 
-    u8g2_uint_t drawSelectionListLine(u8g2_uint_t y, uint8_t idx, const char* s, const char* info = NULL) {
+    u8g2_uint_t drawSelectionListLine(u8g2_uint_t y, uint8_t idx, const char* info = NULL) {
 
         uint8_t is_invert = 0;
+        char buf[ListProvider::ITEM_SIZE];
 
         u8g2_uint_t line_height = (u8g2_uint_t)(ui.lcd()->getAscent() - ui.lcd()->getDescent() + 2);
 
@@ -612,8 +569,8 @@ private:
             is_invert = 1;
         }
 
-        /* get the line from the array */
-        s = u8x8_GetStringLineStart(idx, s);
+        /* get the line from the provider */
+        const char* s = items->getItem(idx, buf);
 
         if (s == NULL) {
             return line_height;
@@ -625,7 +582,7 @@ private:
 
         if (showLineNumbers) {
             ui.setFont(Font::FONT_5_TR);
-            ui.drawStringf(TextAlign::LEFT, startXPos, 0, y, is_invert, true, false, "%02u", idx + 1);
+            ui.drawText(TextAlign::LEFT, startXPos, 0, y, is_invert, true, false, Fmt::zero<2>(idx + 1));
         }
 
         if (is_invert) {
@@ -643,7 +600,7 @@ private:
                     ui.drawString(TextAlign::RIGHT, 0, maxWidth - 2, y, !is_invert, true, false, info);
                 }
                 else {
-                    ui.drawStringf(TextAlign::RIGHT, 0, maxWidth - 2, y, !is_invert, true, false, "%.*s %s", ui.stringLengthNL(info), info, suffix);
+                    ui.drawText(TextAlign::RIGHT, 0, maxWidth - 2, y, !is_invert, true, false, Fmt::line(info), ' ', suffix);
                 }
             }
         }
@@ -653,17 +610,17 @@ private:
                 ui.drawString(TextAlign::CENTER, startXPos, maxWidth, y, is_invert, true, false, s);
             }
             else {
-                ui.drawStringf(TextAlign::CENTER, startXPos, maxWidth, y, is_invert, true, false, "%.*s %s", ui.stringLengthNL(s), s, suffix);
+                ui.drawText(TextAlign::CENTER, startXPos, maxWidth, y, is_invert, true, false, Fmt::line(s), ' ', suffix);
             }
         }
 
         return line_height;
     }
 
-    void drawSelectionList(u8g2_uint_t y, const char* s, const char* info = NULL) {
+    void drawSelectionList(u8g2_uint_t y, const char* info = NULL) {
         uint8_t i;
         for (i = 0; i < u8sl.visible; i++) {
-            y += drawSelectionListLine(y, i + u8sl.first_pos, s, info);
+            y += drawSelectionListLine(y, i + u8sl.first_pos, info);
         }
     }
 